@@ -214,6 +214,14 @@ $(INTERMEDIATE_OUTPUT)/src/config.h: $(KEYMAP_JSON)
 
 generated-files: $(INTERMEDIATE_OUTPUT)/src/config.h $(INTERMEDIATE_OUTPUT)/src/keymap.c
 
+# Without leader sequences the header is left empty, so leader.c never sees those of an older keymap.json
+$(INTERMEDIATE_OUTPUT)/src/leader_data.h: $(KEYMAP_JSON)
+	@$(SILENT) || printf "$(MSG_GENERATING) $@" | $(AWK_CMD)
+	$(eval CMD=$(QMK_BIN) generate-leader-data --quiet --output $(INTERMEDIATE_OUTPUT)/src/leader_data.h $(KEYMAP_JSON))
+	@$(BUILD_CMD)
+
+generated-files: $(INTERMEDIATE_OUTPUT)/src/leader_data.h
+
 endif
 
 include $(BUILDDEFS_PATH)/converters.mk
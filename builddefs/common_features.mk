@@ -44,6 +44,19 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(PROFILING_ENABLE)), yes)
+    OPT_DEFS += -DPROFILING_ENABLE
+    SRC += $(QUANTUM_DIR)/profiling.c
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/profiling_timestamp.c
+endif
+
+# Key events are timed with the profiling timestamp
+ifeq ($(strip $(LATENCY_TRACKER_ENABLE)), yes)
+    ifneq ($(strip $(PROFILING_ENABLE)), yes)
+        SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/profiling_timestamp.c
+    endif
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -458,6 +471,12 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_drivers.c
+    ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
+        ifeq ($(strip $(SPLIT_RGB_MATRIX_FRAME_ENABLE)), yes)
+            OPT_DEFS += -DSPLIT_RGB_MATRIX_FRAME_ENABLE
+            SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix_split_frame.c
+        endif
+    endif
     LIB8TION_ENABLE := yes
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
@@ -667,6 +686,15 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
+        ifeq ($(strip $(SPLIT_TRANSACTION_STATS_ENABLE)), yes)
+            OPT_DEFS += -DSPLIT_TRANSACTION_STATS_ENABLE
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transaction_stats.c
+            # Transfers are timed with the profiling timestamp
+            ifeq ($(filter %/profiling_timestamp.c,$(SRC)),)
+                SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/profiling_timestamp.c
+            endif
+        endif
+
         # Functions added via QUANTUM_LIB_SRC are only included in the final binary if they're called.
         # Unused functions are pruned away, which is why we can add multiple drivers here without bloat.
         ifeq ($(PLATFORM),AVR)
@@ -949,6 +977,13 @@ ifeq ($(strip $(ANALOG_DRIVER_REQUIRED)), yes)
     QUANTUM_LIB_SRC += analog.c
 endif
 
+# Every ISSI driver, whether selected above or added by a keyboard's rules.mk, shares is31_common.c
+ISSI_COMMON_DRIVERS := is31fl3218 is31fl3729 is31fl3731 is31fl3733 is31fl3736 is31fl3737 is31fl3741 is31fl3742a is31fl3743a is31fl3745 is31fl3746a
+ifneq ($(filter $(addsuffix .c,$(ISSI_COMMON_DRIVERS)) $(addsuffix -mono.c,$(ISSI_COMMON_DRIVERS)),$(notdir $(SRC) $(QUANTUM_LIB_SRC))),)
+    COMMON_VPATH += $(DRIVER_PATH)/led/issi
+    SRC += is31_common.c
+endif
+
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "is31_common.h"
+#include "i2c_master.h"
+
+void is31_write_registers(const is31_chip_t *chip, uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length) {
+    // Without persistence, every transfer is attempted once
+    uint8_t attempts = chip->i2c_persistence > 0 ? chip->i2c_persistence : 1;
+
+    for (uint8_t i = 0; i < attempts; i++) {
+        if (i2c_write_register(address << 1, reg, data, length, chip->i2c_timeout) == I2C_STATUS_SUCCESS) break;
+    }
+}
+
+void is31_write_register(const is31_chip_t *chip, uint8_t address, uint8_t reg, uint8_t data) {
+    is31_write_registers(chip, address, reg, &data, 1);
+}
+
+void is31_select_page(const is31_chip_t *chip, uint8_t address, uint8_t page) {
+    if (chip->write_lock) {
+        is31_write_register(chip, address, IS31_REG_COMMAND_WRITE_LOCK, IS31_COMMAND_WRITE_LOCK_MAGIC);
+    }
+    is31_write_register(chip, address, IS31_REG_COMMAND, page);
+}
+
+void is31_write_pwm_buffer(const is31_chip_t *chip, uint8_t address, const uint8_t *buffer, uint16_t dirty) {
+    for (uint8_t p = 0; p < chip->pwm_page_count && dirty; p++) {
+        const is31_pwm_page_t *page       = &chip->pwm_pages[p];
+        uint8_t                chunks     = page->register_count / page->chunk_size;
+        uint16_t               page_dirty = dirty & ((1U << chunks) - 1);
+
+        if (page_dirty && page->page != IS31_PAGE_NONE) {
+            is31_select_page(chip, address, page->page);
+        }
+
+        for (uint8_t i = 0; page_dirty; i += page->chunk_size, page_dirty >>= 1) {
+            if (page_dirty & 1) {
+                is31_write_registers(chip, address, page->first_register + i, buffer + i, page->chunk_size);
+            }
+        }
+
+        buffer += page->register_count;
+        dirty >>= chunks;
+    }
+}
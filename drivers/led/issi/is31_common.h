@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define IS31_REG_COMMAND 0xFD
+#define IS31_REG_COMMAND_WRITE_LOCK 0xFE
+#define IS31_COMMAND_WRITE_LOCK_MAGIC 0xC5
+
+// PWM registers that are accessible without selecting a page first
+#define IS31_PAGE_NONE 0xFF
+
+#define IS31_MAX_PWM_PAGES 2
+
+// Bit of a dirty bitmap covering the chunk of the given buffer index
+#define IS31_CHUNK_BIT(index, chunk_size) (1U << ((index) / (chunk_size)))
+
+typedef struct is31_pwm_page_t {
+    uint8_t page;
+    uint8_t first_register;
+    uint8_t register_count;
+    uint8_t chunk_size;
+} is31_pwm_page_t;
+
+/**
+ * \brief Description of an ISSI LED driver chip, shared by all of its instances.
+ *
+ * The PWM registers of all pages are buffered back to back, and flushed in
+ * chunks of `chunk_size` registers. Each chunk is tracked by one bit of the
+ * dirty bitmap, starting with the first chunk of the first page.
+ */
+typedef struct is31_chip_t {
+    uint16_t        i2c_timeout;
+    uint8_t         i2c_persistence;
+    bool            write_lock;
+    uint8_t         pwm_page_count;
+    is31_pwm_page_t pwm_pages[IS31_MAX_PWM_PAGES];
+} is31_chip_t;
+
+/**
+ * \brief Write a single register.
+ *
+ * \param address The 7 bit I2C address of the chip.
+ */
+void is31_write_register(const is31_chip_t *chip, uint8_t address, uint8_t reg, uint8_t data);
+
+/**
+ * \brief Write consecutive registers in a single transfer, starting at `reg`.
+ */
+void is31_write_registers(const is31_chip_t *chip, uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length);
+
+/**
+ * \brief Select the given page, unlocking the command register first if needed.
+ */
+void is31_select_page(const is31_chip_t *chip, uint8_t address, uint8_t page);
+
+/**
+ * \brief Send the chunks of the PWM buffer that are marked in `dirty`.
+ *
+ * Pages without any dirty chunk are not selected.
+ */
+void is31_write_pwm_buffer(const is31_chip_t *chip, uint8_t address, const uint8_t *buffer, uint16_t dirty);
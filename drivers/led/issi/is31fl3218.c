@@ -15,6 +15,7 @@
  */
 
 #include "is31fl3218.h"
+#include "is31_common.h"
 #include "i2c_master.h"
 #include "gpio.h"
 
@@ -29,6 +30,17 @@
 #    define IS31FL3218_I2C_PERSISTENCE 0
 #endif
 
+static const is31_chip_t is31fl3218_chip = {
+    .i2c_timeout     = IS31FL3218_I2C_TIMEOUT,
+    .i2c_persistence = IS31FL3218_I2C_PERSISTENCE,
+    .write_lock      = false,
+    .pwm_page_count  = 1,
+    .pwm_pages =
+        {
+            {.page = IS31_PAGE_NONE, .first_register = IS31FL3218_REG_PWM, .register_count = IS31FL3218_PWM_REGISTER_COUNT, .chunk_size = IS31FL3218_PWM_REGISTER_COUNT},
+        },
+};
+
 typedef struct is31fl3218_driver_t {
     uint8_t pwm_buffer[IS31FL3218_PWM_REGISTER_COUNT];
     bool    pwm_buffer_dirty;
@@ -45,23 +57,12 @@ is31fl3218_driver_t driver_buffers = {
 };
 
 void is31fl3218_write_register(uint8_t reg, uint8_t data) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, reg, &data, 1, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, reg, &data, 1, IS31FL3218_I2C_TIMEOUT);
-#endif
+    is31_write_register(&is31fl3218_chip, IS31FL3218_I2C_ADDRESS, reg, data);
 }
 
 void is31fl3218_write_pwm_buffer(void) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT);
-#endif
+    // All 18 PWM registers are written in a single transfer
+    is31_write_pwm_buffer(&is31fl3218_chip, IS31FL3218_I2C_ADDRESS, driver_buffers.pwm_buffer, 1);
 }
 
 void is31fl3218_init(void) {
@@ -163,9 +164,7 @@ void is31fl3218_update_pwm_buffers(void) {
 
 void is31fl3218_update_led_control_registers(void) {
     if (driver_buffers.led_control_buffer_dirty) {
-        for (uint8_t i = 0; i < IS31FL3218_LED_CONTROL_REGISTER_COUNT; i++) {
-            is31fl3218_write_register(IS31FL3218_REG_LED_CONTROL_1 + i, driver_buffers.led_control_buffer[i]);
-        }
+        is31_write_registers(&is31fl3218_chip, IS31FL3218_I2C_ADDRESS, IS31FL3218_REG_LED_CONTROL_1, driver_buffers.led_control_buffer, IS31FL3218_LED_CONTROL_REGISTER_COUNT);
 
         driver_buffers.led_control_buffer_dirty = false;
     }
@@ -17,6 +17,7 @@
  */
 
 #include "is31fl3729-mono.h"
+#include "is31_common.h"
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
@@ -24,6 +25,10 @@
 #define IS31FL3729_PWM_REGISTER_COUNT 143
 #define IS31FL3729_SCALING_REGISTER_COUNT 16
 
+// PWM registers are flushed in chunks, each tracked by one bit of pwm_buffer_dirty
+#define IS31FL3729_PWM_CHUNK_SIZE 13
+#define IS31FL3729_PWM_CHUNK_BIT(reg) IS31_CHUNK_BIT(reg, IS31FL3729_PWM_CHUNK_SIZE)
+
 #ifndef IS31FL3729_I2C_TIMEOUT
 #    define IS31FL3729_I2C_TIMEOUT 100
 #endif
@@ -64,6 +69,14 @@
 #    define IS31FL3729_PWM_FREQUENCY IS31FL3729_PWM_FREQUENCY_32K_HZ
 #endif
 
+static const is31_chip_t is31fl3729_chip = {
+    .i2c_timeout     = IS31FL3729_I2C_TIMEOUT,
+    .i2c_persistence = IS31FL3729_I2C_PERSISTENCE,
+    .write_lock      = false,
+    .pwm_page_count  = 1,
+    .pwm_pages       = {{.page = IS31_PAGE_NONE, .first_register = IS31FL3729_REG_PWM, .register_count = IS31FL3729_PWM_REGISTER_COUNT, .chunk_size = IS31FL3729_PWM_CHUNK_SIZE}},
+};
+
 const uint8_t i2c_addresses[IS31FL3729_DRIVER_COUNT] = {
     IS31FL3729_I2C_ADDRESS_1,
 #ifdef IS31FL3729_I2C_ADDRESS_2
@@ -80,42 +93,21 @@ const uint8_t i2c_addresses[IS31FL3729_DRIVER_COUNT] = {
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
 typedef struct is31fl3729_driver_t {
-    uint8_t pwm_buffer[IS31FL3729_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t scaling_buffer[IS31FL3729_SCALING_REGISTER_COUNT];
-    bool    scaling_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3729_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty;
+    uint8_t  scaling_buffer[IS31FL3729_SCALING_REGISTER_COUNT];
+    bool     scaling_buffer_dirty;
 } PACKED is31fl3729_driver_t;
 
 is31fl3729_driver_t driver_buffers[IS31FL3729_DRIVER_COUNT] = {{
     .pwm_buffer           = {0},
-    .pwm_buffer_dirty     = false,
+    .pwm_buffer_dirty     = 0,
     .scaling_buffer       = {0},
     .scaling_buffer_dirty = false,
 }};
 
 void is31fl3729_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3729_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3729_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3729_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3729_I2C_TIMEOUT);
-#endif
-}
-
-void is31fl3729_write_pwm_buffer(uint8_t index) {
-    // Transmit PWM registers in 11 transfers of 13 bytes.
-
-    // Iterate over the pwm_buffer contents at 13 byte intervals.
-    for (uint8_t i = 0; i <= IS31FL3729_PWM_REGISTER_COUNT; i += 13) {
-#if IS31FL3729_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3729_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3729_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 13, IS31FL3729_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, IS31FL3729_REG_PWM + i, driver_buffers[index].pwm_buffer + i, 13, IS31FL3729_I2C_TIMEOUT);
-#endif
-    }
+    is31_write_register(&is31fl3729_chip, i2c_addresses[index], reg, data);
 }
 
 void is31fl3729_init_drivers(void) {
@@ -165,7 +157,7 @@ void is31fl3729_set_value(int index, uint8_t value) {
         }
 
         driver_buffers[led.driver].pwm_buffer[led.v] = value;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= IS31FL3729_PWM_CHUNK_BIT(led.v);
     }
 }
 
@@ -190,17 +182,15 @@ void is31fl3729_set_scaling_register(uint8_t index, uint8_t value) {
 
 void is31fl3729_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        is31fl3729_write_pwm_buffer(index);
+        is31_write_pwm_buffer(&is31fl3729_chip, i2c_addresses[index], driver_buffers[index].pwm_buffer, driver_buffers[index].pwm_buffer_dirty);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
 void is31fl3729_update_scaling_registers(uint8_t index) {
     if (driver_buffers[index].scaling_buffer_dirty) {
-        for (uint8_t i = 0; i < IS31FL3729_SCALING_REGISTER_COUNT; i++) {
-            is31fl3729_write_register(index, IS31FL3729_REG_SCALING + i, driver_buffers[index].scaling_buffer[i]);
-        }
+        is31_write_registers(&is31fl3729_chip, i2c_addresses[index], IS31FL3729_REG_SCALING, driver_buffers[index].scaling_buffer, IS31FL3729_SCALING_REGISTER_COUNT);
 
         driver_buffers[index].scaling_buffer_dirty = false;
     }
@@ -19,6 +19,7 @@
  */
 
 #include "is31fl3733-mono.h"
+#include "is31_common.h"
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
@@ -26,6 +27,10 @@
 #define IS31FL3733_PWM_REGISTER_COUNT 192
 #define IS31FL3733_LED_CONTROL_REGISTER_COUNT 24
 
+// PWM registers are flushed in chunks, each tracked by one bit of pwm_buffer_dirty
+#define IS31FL3733_PWM_CHUNK_SIZE 16
+#define IS31FL3733_PWM_CHUNK_BIT(reg) IS31_CHUNK_BIT(reg, IS31FL3733_PWM_CHUNK_SIZE)
+
 #ifndef IS31FL3733_I2C_TIMEOUT
 #    define IS31FL3733_I2C_TIMEOUT 100
 #endif
@@ -63,6 +68,14 @@
 #    define IS31FL3733_SYNC_4 IS31FL3733_SYNC_NONE
 #endif
 
+static const is31_chip_t is31fl3733_chip = {
+    .i2c_timeout     = IS31FL3733_I2C_TIMEOUT,
+    .i2c_persistence = IS31FL3733_I2C_PERSISTENCE,
+    .write_lock      = true,
+    .pwm_page_count  = 1,
+    .pwm_pages       = {{.page = IS31FL3733_COMMAND_PWM, .first_register = 0x00, .register_count = IS31FL3733_PWM_REGISTER_COUNT, .chunk_size = IS31FL3733_PWM_CHUNK_SIZE}},
+};
+
 const uint8_t i2c_addresses[IS31FL3733_DRIVER_COUNT] = {
     IS31FL3733_I2C_ADDRESS_1,
 #ifdef IS31FL3733_I2C_ADDRESS_2
@@ -93,51 +106,28 @@ const uint8_t driver_sync[IS31FL3733_DRIVER_COUNT] = {
 // The control buffers match the page 0 LED On/Off registers.
 // Storing them like this is optimal for I2C transfers to the registers.
 // We could optimize this and take out the unused registers from these
-// buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
+// buffers and the transfers in is31_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3733_driver_t {
-    uint8_t pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty;
+    uint8_t  led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
+    bool     led_control_buffer_dirty;
 } PACKED is31fl3733_driver_t;
 
 is31fl3733_driver_t driver_buffers[IS31FL3733_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
 }};
 
 void is31fl3733_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3733_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3733_I2C_TIMEOUT);
-#endif
+    is31_write_register(&is31fl3733_chip, i2c_addresses[index], reg, data);
 }
 
 void is31fl3733_select_page(uint8_t index, uint8_t page) {
-    is31fl3733_write_register(index, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
-    is31fl3733_write_register(index, IS31FL3733_REG_COMMAND, page);
-}
-
-void is31fl3733_write_pwm_buffer(uint8_t index) {
-    // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
-
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
-#if IS31FL3733_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3733_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT);
-#endif
-    }
+    is31_select_page(&is31fl3733_chip, i2c_addresses[index], page);
 }
 
 void is31fl3733_init_drivers(void) {
@@ -210,7 +200,7 @@ void is31fl3733_set_value(int index, uint8_t value) {
         }
 
         driver_buffers[led.driver].pwm_buffer[led.v] = value;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= IS31FL3733_PWM_CHUNK_BIT(led.v);
     }
 }
 
@@ -238,11 +228,9 @@ void is31fl3733_set_led_control_register(uint8_t index, bool value) {
 
 void is31fl3733_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        is31fl3733_select_page(index, IS31FL3733_COMMAND_PWM);
-
-        is31fl3733_write_pwm_buffer(index);
+        is31_write_pwm_buffer(&is31fl3733_chip, i2c_addresses[index], driver_buffers[index].pwm_buffer, driver_buffers[index].pwm_buffer_dirty);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -250,9 +238,7 @@ void is31fl3733_update_led_control_registers(uint8_t index) {
     if (driver_buffers[index].led_control_buffer_dirty) {
         is31fl3733_select_page(index, IS31FL3733_COMMAND_LED_CONTROL);
 
-        for (uint8_t i = 0; i < IS31FL3733_LED_CONTROL_REGISTER_COUNT; i++) {
-            is31fl3733_write_register(index, i, driver_buffers[index].led_control_buffer[i]);
-        }
+        is31_write_registers(&is31fl3733_chip, i2c_addresses[index], 0x00, driver_buffers[index].led_control_buffer, IS31FL3733_LED_CONTROL_REGISTER_COUNT);
 
         driver_buffers[index].led_control_buffer_dirty = false;
     }
@@ -18,6 +18,7 @@
  */
 
 #include "is31fl3741.h"
+#include "is31_common.h"
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
@@ -27,6 +28,14 @@
 #define IS31FL3741_SCALING_0_REGISTER_COUNT 180
 #define IS31FL3741_SCALING_1_REGISTER_COUNT 171
 
+// PWM registers are flushed in chunks, each tracked by one bit of pwm_buffer_dirty.
+// The chunks of page 0 use the low bits, followed by those of page 1.
+#define IS31FL3741_PWM_0_CHUNK_SIZE 30
+#define IS31FL3741_PWM_1_CHUNK_SIZE 19
+#define IS31FL3741_PWM_0_CHUNK_COUNT (IS31FL3741_PWM_0_REGISTER_COUNT / IS31FL3741_PWM_0_CHUNK_SIZE)
+#define IS31FL3741_PWM_0_CHUNK_BIT(reg) IS31_CHUNK_BIT(reg, IS31FL3741_PWM_0_CHUNK_SIZE)
+#define IS31FL3741_PWM_1_CHUNK_BIT(reg) (IS31_CHUNK_BIT(reg, IS31FL3741_PWM_1_CHUNK_SIZE) << IS31FL3741_PWM_0_CHUNK_COUNT)
+
 #ifndef IS31FL3741_I2C_TIMEOUT
 #    define IS31FL3741_I2C_TIMEOUT 100
 #endif
@@ -55,6 +64,18 @@
 #    define IS31FL3741_GLOBAL_CURRENT 0xFF
 #endif
 
+static const is31_chip_t is31fl3741_chip = {
+    .i2c_timeout     = IS31FL3741_I2C_TIMEOUT,
+    .i2c_persistence = IS31FL3741_I2C_PERSISTENCE,
+    .write_lock      = true,
+    .pwm_page_count  = 2,
+    .pwm_pages =
+        {
+            {.page = IS31FL3741_COMMAND_PWM_0, .first_register = 0x00, .register_count = IS31FL3741_PWM_0_REGISTER_COUNT, .chunk_size = IS31FL3741_PWM_0_CHUNK_SIZE},
+            {.page = IS31FL3741_COMMAND_PWM_1, .first_register = 0x00, .register_count = IS31FL3741_PWM_1_REGISTER_COUNT, .chunk_size = IS31FL3741_PWM_1_CHUNK_SIZE},
+        },
+};
+
 const uint8_t i2c_addresses[IS31FL3741_DRIVER_COUNT] = {
     IS31FL3741_I2C_ADDRESS_1,
 #ifdef IS31FL3741_I2C_ADDRESS_2
@@ -72,71 +93,30 @@ const uint8_t i2c_addresses[IS31FL3741_DRIVER_COUNT] = {
 // The scaling buffers match the page 2 and 3 LED On/Off registers.
 // Storing them like this is optimal for I2C transfers to the registers.
 // We could optimize this and take out the unused registers from these
-// buffers and the transfers in is31fl3741_write_pwm_buffer() but it's
+// buffers and the transfers in is31_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 typedef struct is31fl3741_driver_t {
-    uint8_t pwm_buffer_0[IS31FL3741_PWM_0_REGISTER_COUNT];
-    uint8_t pwm_buffer_1[IS31FL3741_PWM_1_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t scaling_buffer_0[IS31FL3741_SCALING_0_REGISTER_COUNT];
-    uint8_t scaling_buffer_1[IS31FL3741_SCALING_1_REGISTER_COUNT];
-    bool    scaling_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3741_PWM_0_REGISTER_COUNT + IS31FL3741_PWM_1_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty;
+    uint8_t  scaling_buffer_0[IS31FL3741_SCALING_0_REGISTER_COUNT];
+    uint8_t  scaling_buffer_1[IS31FL3741_SCALING_1_REGISTER_COUNT];
+    bool     scaling_buffer_dirty;
 } PACKED is31fl3741_driver_t;
 
 is31fl3741_driver_t driver_buffers[IS31FL3741_DRIVER_COUNT] = {{
-    .pwm_buffer_0         = {0},
-    .pwm_buffer_1         = {0},
-    .pwm_buffer_dirty     = false,
+    .pwm_buffer           = {0},
+    .pwm_buffer_dirty     = 0,
     .scaling_buffer_0     = {0},
     .scaling_buffer_1     = {0},
     .scaling_buffer_dirty = false,
 }};
 
 void is31fl3741_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3741_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3741_I2C_TIMEOUT);
-#endif
+    is31_write_register(&is31fl3741_chip, i2c_addresses[index], reg, data);
 }
 
 void is31fl3741_select_page(uint8_t index, uint8_t page) {
-    is31fl3741_write_register(index, IS31FL3741_REG_COMMAND_WRITE_LOCK, IS31FL3741_COMMAND_WRITE_LOCK_MAGIC);
-    is31fl3741_write_register(index, IS31FL3741_REG_COMMAND, page);
-}
-
-void is31fl3741_write_pwm_buffer(uint8_t index) {
-    is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_0);
-
-    // Transmit PWM0 registers in 6 transfers of 30 bytes.
-
-    // Iterate over the pwm_buffer_0 contents at 30 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3741_PWM_0_REGISTER_COUNT; i += 30) {
-#if IS31FL3741_I2C_PERSISTENCE > 0
-        for (uint8_t j = 0; j < IS31FL3741_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_0 + i, 30, IS31FL3741_I2C_TIMEOUT);
-#endif
-    }
-
-    is31fl3741_select_page(index, IS31FL3741_COMMAND_PWM_1);
-
-    // Transmit PWM1 registers in 9 transfers of 19 bytes.
-
-    // Iterate over the pwm_buffer_1 contents at 19 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3741_PWM_1_REGISTER_COUNT; i += 19) {
-#if IS31FL3741_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < IS31FL3741_I2C_PERSISTENCE; i++) {
-            if (i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-        }
-#else
-        i2c_write_register(i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer_1 + i, 19, IS31FL3741_I2C_TIMEOUT);
-#endif
-    }
+    is31_select_page(&is31fl3741_chip, i2c_addresses[index], page);
 }
 
 void is31fl3741_init_drivers(void) {
@@ -187,17 +167,19 @@ void is31fl3741_init(uint8_t index) {
 
 uint8_t get_pwm_value(uint8_t driver, uint16_t reg) {
     if (reg & 0x100) {
-        return driver_buffers[driver].pwm_buffer_1[reg & 0xFF];
+        return driver_buffers[driver].pwm_buffer[IS31FL3741_PWM_0_REGISTER_COUNT + (reg & 0xFF)];
     } else {
-        return driver_buffers[driver].pwm_buffer_0[reg];
+        return driver_buffers[driver].pwm_buffer[reg];
     }
 }
 
 void set_pwm_value(uint8_t driver, uint16_t reg, uint8_t value) {
     if (reg & 0x100) {
-        driver_buffers[driver].pwm_buffer_1[reg & 0xFF] = value;
+        driver_buffers[driver].pwm_buffer[IS31FL3741_PWM_0_REGISTER_COUNT + (reg & 0xFF)] = value;
+        driver_buffers[driver].pwm_buffer_dirty |= IS31FL3741_PWM_1_CHUNK_BIT(reg & 0xFF);
     } else {
-        driver_buffers[driver].pwm_buffer_0[reg] = value;
+        driver_buffers[driver].pwm_buffer[reg] = value;
+        driver_buffers[driver].pwm_buffer_dirty |= IS31FL3741_PWM_0_CHUNK_BIT(reg);
     }
 }
 
@@ -214,7 +196,6 @@ void is31fl3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         set_pwm_value(led.driver, led.r, red);
         set_pwm_value(led.driver, led.g, green);
         set_pwm_value(led.driver, led.b, blue);
-        driver_buffers[led.driver].pwm_buffer_dirty = true;
     }
 }
 
@@ -245,9 +226,9 @@ void is31fl3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void is31fl3741_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        is31fl3741_write_pwm_buffer(index);
+        is31_write_pwm_buffer(&is31fl3741_chip, i2c_addresses[index], driver_buffers[index].pwm_buffer, driver_buffers[index].pwm_buffer_dirty);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
@@ -255,22 +236,17 @@ void is31fl3741_set_pwm_buffer(const is31fl3741_led_t *pled, uint8_t red, uint8_
     set_pwm_value(pled->driver, pled->r, red);
     set_pwm_value(pled->driver, pled->g, green);
     set_pwm_value(pled->driver, pled->b, blue);
-    driver_buffers[pled->driver].pwm_buffer_dirty = true;
 }
 
 void is31fl3741_update_led_control_registers(uint8_t index) {
     if (driver_buffers[index].scaling_buffer_dirty) {
         is31fl3741_select_page(index, IS31FL3741_COMMAND_SCALING_0);
 
-        for (uint8_t i = 0; i < IS31FL3741_SCALING_0_REGISTER_COUNT; i++) {
-            is31fl3741_write_register(index, i, driver_buffers[index].scaling_buffer_0[i]);
-        }
+        is31_write_registers(&is31fl3741_chip, i2c_addresses[index], 0x00, driver_buffers[index].scaling_buffer_0, IS31FL3741_SCALING_0_REGISTER_COUNT);
 
         is31fl3741_select_page(index, IS31FL3741_COMMAND_SCALING_1);
 
-        for (uint8_t i = 0; i < IS31FL3741_SCALING_1_REGISTER_COUNT; i++) {
-            is31fl3741_write_register(index, i, driver_buffers[index].scaling_buffer_1[i]);
-        }
+        is31_write_registers(&is31fl3741_chip, i2c_addresses[index], 0x00, driver_buffers[index].scaling_buffer_1, IS31FL3741_SCALING_1_REGISTER_COUNT);
 
         driver_buffers[index].scaling_buffer_dirty = false;
     }
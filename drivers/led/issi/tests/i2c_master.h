@@ -0,0 +1,29 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stand-in for the platform I2C driver, recording every register write
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+
+typedef struct i2c_mock_write_t {
+    uint8_t  devaddr;
+    uint8_t  regaddr;
+    uint16_t length;
+    uint8_t  first_byte;
+} i2c_mock_write_t;
+
+void             i2c_mock_reset(void);
+uint16_t         i2c_mock_write_count(void);
+uint32_t         i2c_mock_byte_count(void);
+i2c_mock_write_t i2c_mock_write(uint16_t index);
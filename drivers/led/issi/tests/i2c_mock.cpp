@@ -0,0 +1,37 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+extern "C" {
+#include "i2c_master.h"
+}
+
+static std::vector<i2c_mock_write_t> writes;
+
+extern "C" void i2c_init(void) {}
+
+extern "C" i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    writes.push_back({devaddr, regaddr, length, data[0]});
+    return I2C_STATUS_SUCCESS;
+}
+
+extern "C" void i2c_mock_reset(void) {
+    writes.clear();
+}
+
+extern "C" uint16_t i2c_mock_write_count(void) {
+    return writes.size();
+}
+
+extern "C" uint32_t i2c_mock_byte_count(void) {
+    uint32_t bytes = 0;
+    for (auto& write : writes) {
+        bytes += write.length;
+    }
+    return bytes;
+}
+
+extern "C" i2c_mock_write_t i2c_mock_write(uint16_t index) {
+    return writes.at(index);
+}
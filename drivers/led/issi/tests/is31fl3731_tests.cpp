@@ -0,0 +1,86 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "is31fl3731.h"
+#include "i2c_master.h"
+}
+
+#define PWM_REGISTER(reg) (IS31FL3731_FRAME_REG_PWM + (reg))
+
+// clang-format off
+extern "C" const is31fl3731_led_t PROGMEM g_is31fl3731_leds[IS31FL3731_LED_COUNT] = {
+    {0, C1_1, C2_1, C3_1},
+    {0, C1_2, C2_2, C3_2},
+    {0, C9_1, C9_2, C9_3},
+};
+// clang-format on
+
+class IS31FL3731 : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        is31fl3731_init_drivers();
+        // Leave every chunk clean, with all LEDs off
+        is31fl3731_set_color_all(0, 0, 0);
+        is31fl3731_flush();
+        i2c_mock_reset();
+    }
+};
+
+TEST_F(IS31FL3731, NothingChangedSendsNothing) {
+    is31fl3731_flush();
+    EXPECT_EQ(i2c_mock_write_count(), 0);
+
+    is31fl3731_set_color(0, 0, 0, 0);
+    is31fl3731_flush();
+    EXPECT_EQ(i2c_mock_write_count(), 0);
+}
+
+TEST_F(IS31FL3731, SingleLedSendsItsChunks) {
+    is31fl3731_set_color(0, 255, 128, 0);
+    is31fl3731_flush();
+
+    // Red, green and blue are 16 registers apart, one chunk each
+    ASSERT_EQ(i2c_mock_write_count(), 3);
+    EXPECT_EQ(i2c_mock_byte_count(), 3 * 16);
+    EXPECT_EQ(i2c_mock_write(0).regaddr, PWM_REGISTER(C1_1));
+    EXPECT_EQ(i2c_mock_write(1).regaddr, PWM_REGISTER(C2_1));
+    EXPECT_EQ(i2c_mock_write(2).regaddr, PWM_REGISTER(C3_1));
+
+    i2c_mock_reset();
+    is31fl3731_flush();
+    EXPECT_EQ(i2c_mock_write_count(), 0);
+}
+
+TEST_F(IS31FL3731, LedsInOneChunkAreSentTogether) {
+    is31fl3731_set_color(2, 10, 20, 30);
+    is31fl3731_flush();
+
+    ASSERT_EQ(i2c_mock_write_count(), 1);
+    EXPECT_EQ(i2c_mock_write(0).regaddr, PWM_REGISTER(C9_1));
+    EXPECT_EQ(i2c_mock_write(0).length, 16);
+
+    i2c_mock_reset();
+    is31fl3731_set_color(0, 10, 20, 30);
+    is31fl3731_set_color(1, 10, 20, 30);
+    is31fl3731_flush();
+    EXPECT_EQ(i2c_mock_write_count(), 3);
+}
+
+TEST_F(IS31FL3731, FrameBytes) {
+    // A reactive effect touching a single LED per frame
+    for (uint8_t frame = 1; frame <= 10; frame++) {
+        is31fl3731_set_color(2, frame, frame, frame);
+        is31fl3731_flush();
+    }
+    EXPECT_EQ(i2c_mock_byte_count(), 10 * 16);
+
+    // Changing every LED still sends only the chunks they use
+    i2c_mock_reset();
+    is31fl3731_set_color_all(255, 255, 255);
+    is31fl3731_flush();
+    EXPECT_EQ(i2c_mock_write_count(), 4);
+    EXPECT_EQ(i2c_mock_byte_count(), 4 * 16);
+}
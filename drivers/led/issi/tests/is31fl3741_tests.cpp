@@ -0,0 +1,77 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "is31fl3741.h"
+#include "i2c_master.h"
+}
+
+// clang-format off
+extern "C" const is31fl3741_led_t PROGMEM g_is31fl3741_leds[IS31FL3741_LED_COUNT] = {
+    {0, SW1_CS1, SW1_CS2, SW1_CS3},
+    {0, SW7_CS1, SW7_CS2, SW7_CS3},
+    {0, SW1_CS4, SW7_CS4, SW9_CS39},
+};
+// clang-format on
+
+class IS31FL3741 : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        is31fl3741_init_drivers();
+        // Leave every chunk clean, with all LEDs off
+        is31fl3741_set_color_all(0, 0, 0);
+        is31fl3741_flush();
+        i2c_mock_reset();
+    }
+
+    uint16_t page_selects(uint8_t page) {
+        uint16_t count = 0;
+        for (uint16_t i = 0; i < i2c_mock_write_count(); i++) {
+            i2c_mock_write_t write = i2c_mock_write(i);
+            if (write.regaddr == IS31FL3741_REG_COMMAND && write.first_byte == page) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(IS31FL3741, NothingChangedSendsNothing) {
+    is31fl3741_flush();
+    EXPECT_EQ(i2c_mock_write_count(), 0);
+}
+
+TEST_F(IS31FL3741, OnlyChangedPageIsSelected) {
+    is31fl3741_set_color(0, 1, 2, 3);
+    is31fl3741_flush();
+
+    EXPECT_EQ(page_selects(IS31FL3741_COMMAND_PWM_0), 1);
+    EXPECT_EQ(page_selects(IS31FL3741_COMMAND_PWM_1), 0);
+    // Page select (unlock and command), then a single chunk
+    ASSERT_EQ(i2c_mock_write_count(), 3);
+    EXPECT_EQ(i2c_mock_write(2).regaddr, SW1_CS1);
+    EXPECT_EQ(i2c_mock_write(2).length, 30);
+
+    i2c_mock_reset();
+    is31fl3741_set_color(1, 1, 2, 3);
+    is31fl3741_flush();
+
+    EXPECT_EQ(page_selects(IS31FL3741_COMMAND_PWM_0), 0);
+    EXPECT_EQ(page_selects(IS31FL3741_COMMAND_PWM_1), 1);
+    ASSERT_EQ(i2c_mock_write_count(), 3);
+    EXPECT_EQ(i2c_mock_write(2).regaddr, SW7_CS1 & 0xFF);
+    EXPECT_EQ(i2c_mock_write(2).length, 19);
+}
+
+TEST_F(IS31FL3741, LedAcrossPages) {
+    is31fl3741_set_color(2, 1, 2, 3);
+    is31fl3741_flush();
+
+    EXPECT_EQ(page_selects(IS31FL3741_COMMAND_PWM_0), 1);
+    EXPECT_EQ(page_selects(IS31FL3741_COMMAND_PWM_1), 1);
+    // Two page selects, one chunk of page 0 and two of page 1
+    EXPECT_EQ(i2c_mock_write_count(), 2 * 2 + 3);
+    EXPECT_EQ(i2c_mock_byte_count(), 2 * 2 + 30 + 2 * 19);
+}
@@ -0,0 +1,30 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+ISSI_TESTS_PATH := $(DRIVER_PATH)/led/issi/tests
+
+issi_is31fl3731_DEFS := \
+	-DIS31FL3731_I2C_ADDRESS_1=0x74 \
+	-DIS31FL3731_LED_COUNT=3
+issi_is31fl3731_INC := \
+	$(DRIVER_PATH)/led/issi \
+	$(ISSI_TESTS_PATH)
+issi_is31fl3731_SRC := \
+	$(DRIVER_PATH)/led/issi/is31fl3731.c \
+	$(DRIVER_PATH)/led/issi/is31_common.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(ISSI_TESTS_PATH)/i2c_mock.cpp \
+	$(ISSI_TESTS_PATH)/is31fl3731_tests.cpp
+
+issi_is31fl3741_DEFS := \
+	-DIS31FL3741_I2C_ADDRESS_1=0x30 \
+	-DIS31FL3741_LED_COUNT=3
+issi_is31fl3741_INC := \
+	$(DRIVER_PATH)/led/issi \
+	$(ISSI_TESTS_PATH)
+issi_is31fl3741_SRC := \
+	$(DRIVER_PATH)/led/issi/is31fl3741.c \
+	$(DRIVER_PATH)/led/issi/is31_common.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(ISSI_TESTS_PATH)/i2c_mock.cpp \
+	$(ISSI_TESTS_PATH)/is31fl3741_tests.cpp
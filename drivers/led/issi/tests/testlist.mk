@@ -0,0 +1,3 @@
+TEST_LIST += \
+	issi_is31fl3731 \
+	issi_is31fl3741
@@ -25,11 +25,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif
 #include "oled_driver.h"
 #include OLED_FONT_H
+#include "keyboard.h"
 #include "timer.h"
 #include "print.h"
 #include <string.h>
 #include "progmem.h"
 #include "wait.h"
+#include "util.h"
 
 // Used commands from spec sheet: https://cdn-shop.adafruit.com/datasheets/SSD1306.pdf
 // for SH1106: https://www.velleman.eu/downloads/29/infosheets/sh1106_datasheet.pdf
@@ -968,6 +970,40 @@ void oled_task(void) {
 #endif
 }
 
+uint32_t oled_idle_time(void) {
+    if (!oled_initialized) {
+        return IDLE_TIME_FOREVER;
+    }
+
+#if OLED_UPDATE_INTERVAL > 0
+    if (oled_dirty) {
+        return 0;
+    }
+
+    uint16_t elapsed   = timer_elapsed(oled_update_timeout);
+    uint32_t idle_time = elapsed >= OLED_UPDATE_INTERVAL ? 0 : OLED_UPDATE_INTERVAL - elapsed;
+
+#    if OLED_TIMEOUT > 0
+    if (oled_active) {
+        uint32_t now = timer_read32();
+        idle_time    = MIN(idle_time, timer_expired32(now, oled_timeout) ? 0 : TIMER_DIFF_32(oled_timeout, now));
+    }
+#    endif
+
+#    if OLED_SCROLL_TIMEOUT > 0
+    if (!oled_scrolling) {
+        uint32_t now = timer_read32();
+        idle_time    = MIN(idle_time, timer_expired32(now, oled_scroll_timeout) ? 0 : TIMER_DIFF_32(oled_scroll_timeout, now));
+    }
+#    endif
+
+    return idle_time;
+#else
+    // oled_task_user is called on every loop iteration
+    return 0;
+#endif
+}
+
 __attribute__((weak)) bool oled_task_kb(void) {
     return oled_task_user();
 }
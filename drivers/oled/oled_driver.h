@@ -446,6 +446,9 @@ uint8_t oled_get_brightness(void);
 // Basically it's oled_render, but with timeout management and oled_task_user calling!
 void oled_task(void);
 
+// Number of milliseconds until oled_task has work to do, 0 if it runs on every loop iteration
+uint32_t oled_idle_time(void);
+
 // Called at the start of oled_task, weak function overridable by the user
 bool oled_task_kb(void);
 bool oled_task_user(void);
@@ -0,0 +1,133 @@
+"""Generate leader_data.h from the leader sequences of a keymap.json.
+
+The sequences are compiled into a trie which quantum/leader.c walks one key at
+a time, so a sequence fires as soon as no longer sequence can still match.
+
+Each sequence is listed under "leader_sequences" in the keymap.json:
+
+    "leader_sequences": [
+        {"sequence": ["KC_F", "KC_S"], "keycode": "LCTL(KC_S)"},
+        {"sequence": ["KC_D", "KC_D"], "keycode": "KC_DEL"}
+    ]
+"""
+import textwrap
+
+from argcomplete.completers import FilesCompleter
+from milc import cli
+
+from qmk.c_parse import parse_config_h_file
+from qmk.commands import dump_lines, parse_configurator_json
+from qmk.constants import QMK_FIRMWARE, GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
+from qmk.path import FileType, normpath
+
+# Node header flag marking a node that completes a sequence
+LEADER_TRIE_HAS_KEYCODE = 0x8000
+
+
+def leader_sequence_max_length():
+    """Returns the number of keys quantum/leader.c can hold in its sequence buffer.
+    """
+    leader_h = parse_config_h_file(QMK_FIRMWARE / 'quantum' / 'leader.h')
+
+    return int(leader_h['LEADER_SEQUENCE_MAX_LENGTH'])
+
+
+def make_trie(sequences):
+    """Builds a trie of dicts from the leader sequences.
+
+    Each node maps the next key to a child node under 'children', and holds the keycode to send under 'keycode' if a sequence ends at it.
+    """
+    trie = {}
+    max_length = leader_sequence_max_length()
+
+    for index, entry in enumerate(sequences):
+        sequence = entry.get('sequence', [])
+        keycode = entry.get('keycode')
+
+        if not sequence or len(sequence) > max_length:
+            cli.log.error('{fg_red}Error:{fg_reset} Leader sequence %d must have between 1 and %d keys.', index, max_length)
+            return None
+
+        node = trie
+        for key in sequence:
+            node = node.setdefault('children', {}).setdefault(key, {})
+
+        if 'keycode' in node:
+            cli.log.error('{fg_red}Error:{fg_reset} Leader sequence %d (%s) is defined more than once.', index, ', '.join(sequence))
+            return None
+
+        node['keycode'] = keycode
+
+    return trie
+
+
+def serialize_trie(trie):
+    """Serializes the trie into a flat list of 16 bit words, as C expressions.
+
+    Every node starts with a header word holding the number of children, with bit 15 set if a sequence ends at the node. If it is set, the keycode to send follows. Then come pairs of (key, offset of the child node).
+    """
+    words = []
+
+    def serialize(node):
+        start = len(words)
+        children = node.get('children', {})
+
+        header = len(children)
+        if 'keycode' in node:
+            header |= LEADER_TRIE_HAS_KEYCODE
+        words.append(f'0x{header:04X}')
+        if 'keycode' in node:
+            words.append(node['keycode'])
+
+        # Reserve the links, then fill in the offsets once each child is placed
+        links = len(words)
+        words.extend([None] * (2 * len(children)))
+        for i, (key, child) in enumerate(children.items()):
+            words[links + 2 * i] = key
+            words[links + 2 * i + 1] = str(serialize(child))
+
+        return start
+
+    serialize(trie)
+
+    if len(words) > 0xFFFF:
+        cli.log.error('{fg_red}Error:{fg_reset} The leader trie is too large, it exceeds 65535 words.')
+        return None
+
+    return words
+
+
+@cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('filename', type=FileType('r'), arg_only=True, completer=FilesCompleter('.json'), help='keymap.json file')
+@cli.subcommand('Generate the leader sequence trie from a keymap.json.')
+def generate_leader_data(cli):
+    """Generates leader_data.h from the leader sequences of a keymap.json.
+    """
+    keymap_json = parse_configurator_json(cli.args.filename)
+    sequences = keymap_json.get('leader_sequences', [])
+
+    lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
+
+    if sequences:
+        trie = make_trie(sequences)
+        if trie is None:
+            return False
+
+        words = serialize_trie(trie)
+        if words is None:
+            return False
+
+        lines.append(f'// Leader sequences ({len(sequences)} entries):')
+        for entry in sequences:
+            lines.append(f'//   {" ".join(entry["sequence"])} -> {entry["keycode"]}')
+        lines.append('')
+        lines.append(f'#define LEADER_TRIE_SIZE {len(words)}')
+        lines.append('')
+        lines.append('static const uint16_t leader_trie[LEADER_TRIE_SIZE] PROGMEM = {')
+        lines.append(textwrap.fill('    %s' % (', '.join(words)), width=100, subsequent_indent='    ', break_long_words=False, break_on_hyphens=False))
+        lines.append('};')
+    else:
+        lines.append('// No leader sequences defined')
+
+    dump_lines(cli.args.output, lines, cli.args.quiet)
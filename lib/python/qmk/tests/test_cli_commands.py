@@ -286,6 +286,26 @@ def test_generate_rules_mk():
     assert 'MCU ?= atmega32u4' in result.stdout
 
 
+def test_generate_leader_data():
+    result = check_subcommand('generate-leader-data', 'lib/python/qmk/tests/leader_keymap.json')
+    check_returncode(result)
+    assert '#define LEADER_TRIE_SIZE 16' in result.stdout
+    assert '0x0002, KC_F, 5, KC_D, 11, 0x8001, KC_F1, KC_S, 9, 0x8000, LCTL(KC_S), 0x0001, KC_D, 14, 0x8000,' in result.stdout
+
+
+def test_generate_leader_data_none():
+    result = check_subcommand('generate-leader-data', 'lib/python/qmk/tests/minimal_keymap.json')
+    check_returncode(result)
+    assert '// No leader sequences defined' in result.stdout
+    assert 'LEADER_TRIE_SIZE' not in result.stdout
+
+
+def test_generate_leader_data_too_long():
+    result = check_subcommand('generate-leader-data', 'lib/python/qmk/tests/leader_keymap_too_long.json')
+    check_returncode(result, [1])
+    assert 'Leader sequence 0 must have between 1 and 5 keys.' in result.stdout
+
+
 def test_generate_version_h():
     result = check_subcommand('generate-version-h')
     check_returncode(result)
@@ -79,3 +79,11 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((PORT->Group[SAMD_PORT(pin)].IN.reg & SAMD_PIN_MASK(pin)) != 0)
 
 #define gpio_toggle_pin(pin) (PORT->Group[SAMD_PORT(pin)].OUTTGL.reg = SAMD_PIN_MASK(pin))
+
+/* Operation of GPIO by port. */
+
+typedef uint32_t gpio_port_data_t;
+
+#define gpio_same_port(pin_a, pin_b) (SAMD_PORT(pin_a) == SAMD_PORT(pin_b))
+#define gpio_pin_mask(pin) ((gpio_port_data_t)SAMD_PIN_MASK(pin))
+#define gpio_read_port(pin) ((gpio_port_data_t)PORT->Group[SAMD_PORT(pin)].IN.reg)
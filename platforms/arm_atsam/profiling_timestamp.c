@@ -0,0 +1,19 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "samd51j18a.h"
+#include "tmk_core/protocol/arm_atsam/clks.h"
+#include "profiling.h"
+
+uint32_t profiling_timestamp(void) {
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+}
+
+uint32_t profiling_timestamp_frequency(void) {
+    return system_clks.freq_dpll[0];
+}
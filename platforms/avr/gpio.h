@@ -36,3 +36,11 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define gpio_toggle_pin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t gpio_port_data_t;
+
+#define gpio_same_port(pin_a, pin_b) (((pin_a) >> PORT_SHIFTER) == ((pin_b) >> PORT_SHIFTER))
+#define gpio_pin_mask(pin) ((gpio_port_data_t)_BV((pin)&0xF))
+#define gpio_read_port(pin) ((gpio_port_data_t)PINx_ADDRESS(pin))
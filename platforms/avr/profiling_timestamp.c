@@ -0,0 +1,37 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <avr/io.h>
+#include <util/atomic.h>
+#include "timer_avr.h"
+#include "profiling.h"
+
+extern volatile uint32_t timer_count;
+
+#if defined(__AVR_ATmega32A__)
+#    define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0))
+#elif defined(__AVR_ATtiny85__)
+#    define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0A))
+#else
+#    define TIMER_COMPARE_PENDING() (TIFR0 & _BV(OCF0A))
+#endif
+
+// Timer0 runs in CTC mode and interrupts every millisecond, so the raw counter
+// extends the millisecond count to the resolution of the timer prescaler.
+uint32_t profiling_timestamp(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        raw = TIMER_RAW;
+        ms  = timer_count;
+        // the counter has wrapped but the interrupt is still pending
+        if (TIMER_COMPARE_PENDING() && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+}
+
+uint32_t profiling_timestamp_frequency(void) {
+    return (uint32_t)(TIMER_RAW_TOP + 1) * 1000;
+}
@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "color.h"
+
+/*
+ * The SPI driver sends every WS2812 data bit as 4 SPI bits, 0b1110 for a one
+ * and 0b1000 for a zero, so each byte of colour data expands to 4 SPI bytes,
+ * most significant bit pair first.
+ *
+ * The expansion of all 256 byte values is precomputed into a lookup table,
+ * which turns the encoding of a colour channel into a single 4 byte copy.
+ */
+#define WS2812_SPI_BYTES_PER_BYTE 4
+
+#define WS2812_SPI_BIT_PAIR(bits) ((((bits)&2) ? 0xE0 : 0x80) | (((bits)&1) ? 0x0E : 0x08))
+#define WS2812_SPI_ENCODE(b) \
+    { WS2812_SPI_BIT_PAIR((b) >> 6), WS2812_SPI_BIT_PAIR((b) >> 4), WS2812_SPI_BIT_PAIR((b) >> 2), WS2812_SPI_BIT_PAIR(b) }
+#define WS2812_SPI_ENCODE_4(b) WS2812_SPI_ENCODE(b), WS2812_SPI_ENCODE((b) + 1), WS2812_SPI_ENCODE((b) + 2), WS2812_SPI_ENCODE((b) + 3)
+#define WS2812_SPI_ENCODE_16(b) WS2812_SPI_ENCODE_4(b), WS2812_SPI_ENCODE_4((b) + 4), WS2812_SPI_ENCODE_4((b) + 8), WS2812_SPI_ENCODE_4((b) + 12)
+#define WS2812_SPI_ENCODE_64(b) WS2812_SPI_ENCODE_16(b), WS2812_SPI_ENCODE_16((b) + 16), WS2812_SPI_ENCODE_16((b) + 32), WS2812_SPI_ENCODE_16((b) + 48)
+
+static const uint8_t ws2812_spi_lut[256][WS2812_SPI_BYTES_PER_BYTE] = {
+    WS2812_SPI_ENCODE_64(0),
+    WS2812_SPI_ENCODE_64(64),
+    WS2812_SPI_ENCODE_64(128),
+    WS2812_SPI_ENCODE_64(192),
+};
+
+#ifdef RGBW
+#    define WS2812_SPI_CHANNELS 4
+#else
+#    define WS2812_SPI_CHANNELS 3
+#endif
+#define WS2812_SPI_BYTES_PER_LED (WS2812_SPI_BYTES_PER_BYTE * WS2812_SPI_CHANNELS)
+
+static inline void ws2812_spi_encode_byte(uint8_t *dst, uint8_t data) {
+    memcpy(dst, ws2812_spi_lut[data], WS2812_SPI_BYTES_PER_BYTE);
+}
+
+/**
+ * \brief Encode the colour of one LED into `WS2812_SPI_BYTES_PER_LED` SPI bytes, in the configured byte order.
+ */
+static inline void ws2812_spi_encode_led(uint8_t *dst, rgb_led_t color) {
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+    ws2812_spi_encode_byte(dst, color.g);
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE, color.r);
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE * 2, color.b);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
+    ws2812_spi_encode_byte(dst, color.r);
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE, color.g);
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE * 2, color.b);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+    ws2812_spi_encode_byte(dst, color.b);
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE, color.g);
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE * 2, color.r);
+#endif
+#ifdef RGBW
+    ws2812_spi_encode_byte(dst + WS2812_SPI_BYTES_PER_BYTE * 3, color.w);
+#endif
+}
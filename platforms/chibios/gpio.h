@@ -43,3 +43,22 @@ typedef ioline_t pin_t;
 #define gpio_read_pin(pin) palReadLine(pin)
 
 #define gpio_toggle_pin(pin) palToggleLine(pin)
+
+/* Operation of GPIO by port. */
+
+typedef ioportmask_t gpio_port_data_t;
+
+#define gpio_same_port(pin_a, pin_b) (PAL_PORT(pin_a) == PAL_PORT(pin_b))
+#define gpio_pin_mask(pin) ((gpio_port_data_t)PAL_PORT_BIT(PAL_PAD(pin)))
+#define gpio_read_port(pin) palReadPort(PAL_PORT(pin))
+
+/* Pin change interrupts, which need PAL events enabled in halconf.h. */
+
+#if (PAL_USE_CALLBACKS == TRUE) || (PAL_USE_WAIT == TRUE)
+#    define gpio_enable_pin_interrupt(pin) palEnableLineEvent((pin), PAL_EVENT_MODE_BOTH_EDGES)
+#    define gpio_disable_pin_interrupt(pin) palDisableLineEvent(pin)
+/* Only RP2040 has an interrupt per pin, EXTI style controllers share one line between the pads of the same number on every port. */
+#    if !defined(MCU_RP)
+#        define gpio_pin_interrupt_line(pin) PAL_PAD(pin)
+#    endif
+#endif
@@ -0,0 +1,25 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include "chibios_config.h"
+#include "profiling.h"
+
+#if PORT_SUPPORTS_RT == TRUE
+uint32_t profiling_timestamp(void) {
+    return (uint32_t)chSysGetRealtimeCounterX();
+}
+
+uint32_t profiling_timestamp_frequency(void) {
+    return REALTIME_COUNTER_CLOCK;
+}
+#else
+// No cycle counter available, fall back to the system tick
+uint32_t profiling_timestamp(void) {
+    return (uint32_t)chVTGetSystemTimeX();
+}
+
+uint32_t profiling_timestamp_frequency(void) {
+    return CH_CFG_ST_FREQUENCY;
+}
+#endif
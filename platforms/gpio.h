@@ -21,6 +21,27 @@
 #    include_next "gpio.h" /* Include the platforms gpio.h */
 #endif
 
+// ======== Pin change interrupts ========
+// gpio_enable_pin_interrupt(pin) arms an interrupt on both edges of an input pin, so that a change
+// wakes the MCU from sleep. Platforms without support compile these away, and callers keep polling.
+// gpio_pin_interrupt_line(pin) identifies the interrupt a pin uses; pins on the same line can't be
+// armed at the same time.
+
+#ifdef gpio_enable_pin_interrupt
+#    define GPIO_PIN_INTERRUPT_SUPPORTED
+#else
+#    define gpio_enable_pin_interrupt(pin) \
+        do {                               \
+        } while (0)
+#    define gpio_disable_pin_interrupt(pin) \
+        do {                                \
+        } while (0)
+#endif
+
+#ifndef gpio_pin_interrupt_line
+#    define gpio_pin_interrupt_line(pin) (pin)
+#endif
+
 // ======== DEPRECATED DEFINES - DO NOT USE ========
 
 #define setPinInput(pin) gpio_set_pin_input(pin)
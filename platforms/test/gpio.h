@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// The test platform has no GPIO, unit tests that need pins opt in to the mock
+#ifdef GPIO_MOCK
+#    include "gpio_mock.h"
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "gpio_mock.h"
+
+#define GPIO_MOCK_PIN_COUNT (GPIO_MOCK_PORT_COUNT * 16)
+
+static bool     pin_is_output[GPIO_MOCK_PIN_COUNT];
+static bool     pin_output_level[GPIO_MOCK_PIN_COUNT];
+static bool     pin_interrupt[GPIO_MOCK_PIN_COUNT];
+static bool     switch_closed[GPIO_MOCK_PIN_COUNT][GPIO_MOCK_PIN_COUNT];
+static uint32_t pin_reads;
+static uint32_t port_reads;
+
+static bool pin_level(pin_t pin) {
+    if (pin_is_output[pin]) {
+        return pin_output_level[pin];
+    }
+
+    // An input follows any output driven low through a closed switch, otherwise it is pulled high
+    for (uint16_t other = 0; other < GPIO_MOCK_PIN_COUNT; other++) {
+        if (switch_closed[pin][other] && pin_is_output[other] && !pin_output_level[other]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void gpio_mock_set_pin_input(pin_t pin) {
+    pin_is_output[pin] = false;
+}
+
+void gpio_mock_set_pin_output(pin_t pin) {
+    pin_is_output[pin] = true;
+}
+
+void gpio_mock_write_pin(pin_t pin, bool level) {
+    pin_output_level[pin] = level;
+}
+
+bool gpio_mock_read_pin(pin_t pin) {
+    pin_reads++;
+    return pin_level(pin);
+}
+
+gpio_port_data_t gpio_mock_read_port(pin_t pin) {
+    gpio_port_data_t value = 0;
+    pin_t            first = pin & 0xF0;
+
+    port_reads++;
+    for (uint8_t pad = 0; pad < 16; pad++) {
+        if (pin_level(first + pad)) {
+            value |= (gpio_port_data_t)1 << pad;
+        }
+    }
+    return value;
+}
+
+void gpio_mock_reset(void) {
+    memset(pin_is_output, 0, sizeof(pin_is_output));
+    memset(pin_output_level, 0, sizeof(pin_output_level));
+    memset(pin_interrupt, 0, sizeof(pin_interrupt));
+    memset(switch_closed, 0, sizeof(switch_closed));
+    pin_reads  = 0;
+    port_reads = 0;
+}
+
+void gpio_mock_set_switch(pin_t pin_a, pin_t pin_b, bool closed) {
+    switch_closed[pin_a][pin_b] = closed;
+    switch_closed[pin_b][pin_a] = closed;
+}
+
+void gpio_mock_set_pin_interrupt(pin_t pin, bool enabled) {
+    pin_interrupt[pin] = enabled;
+}
+
+bool gpio_mock_pin_interrupt_enabled(pin_t pin) {
+    return pin_interrupt[pin];
+}
+
+uint32_t gpio_mock_pin_reads(void) {
+    return pin_reads;
+}
+
+uint32_t gpio_mock_port_reads(void) {
+    return port_reads;
+}
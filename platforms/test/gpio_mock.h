@@ -0,0 +1,67 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * GPIO mock for unit tests.
+ *
+ * Pins are grouped into ports of 16 pins like on most ARM MCUs, with the port
+ * in the high nibble of the pin. Every pin idles high through its pull-up
+ * unless it is an output driven low, or a closed switch connects it to one,
+ * which is enough to simulate a key matrix.
+ */
+typedef uint8_t  pin_t;
+typedef uint16_t gpio_port_data_t;
+
+#define GPIO_MOCK_PORT_COUNT 16
+#define GPIO_MOCK_PIN(port, pad) ((pin_t)(((port) << 4) | (pad)))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void             gpio_mock_set_pin_input(pin_t pin);
+void             gpio_mock_set_pin_output(pin_t pin);
+void             gpio_mock_write_pin(pin_t pin, bool level);
+bool             gpio_mock_read_pin(pin_t pin);
+gpio_port_data_t gpio_mock_read_port(pin_t pin);
+
+/** \brief Reset all pins to floating inputs, open all switches and clear the access counters. */
+void gpio_mock_reset(void);
+/** \brief Open or close the switch between two pins. */
+void gpio_mock_set_switch(pin_t pin_a, pin_t pin_b, bool closed);
+/** \brief Whether a pin change interrupt is armed on the pin. */
+bool gpio_mock_pin_interrupt_enabled(pin_t pin);
+void gpio_mock_set_pin_interrupt(pin_t pin, bool enabled);
+/** \brief Number of gpio_read_pin() calls since the last reset. */
+uint32_t gpio_mock_pin_reads(void);
+/** \brief Number of gpio_read_port() calls since the last reset. */
+uint32_t gpio_mock_port_reads(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define gpio_set_pin_input(pin) gpio_mock_set_pin_input(pin)
+#define gpio_set_pin_input_high(pin) gpio_mock_set_pin_input(pin)
+#define gpio_set_pin_output_push_pull(pin) gpio_mock_set_pin_output(pin)
+#define gpio_set_pin_output(pin) gpio_set_pin_output_push_pull(pin)
+
+#define gpio_write_pin_high(pin) gpio_mock_write_pin(pin, true)
+#define gpio_write_pin_low(pin) gpio_mock_write_pin(pin, false)
+#define gpio_write_pin(pin, level) gpio_mock_write_pin(pin, level)
+
+#define gpio_read_pin(pin) gpio_mock_read_pin(pin)
+
+#define gpio_same_port(pin_a, pin_b) (((pin_a) >> 4) == ((pin_b) >> 4))
+#define gpio_pin_mask(pin) ((gpio_port_data_t)(1 << ((pin)&0xF)))
+#define gpio_read_port(pin) gpio_mock_read_port(pin)
+
+#define gpio_enable_pin_interrupt(pin) gpio_mock_set_pin_interrupt(pin, true)
+#define gpio_disable_pin_interrupt(pin) gpio_mock_set_pin_interrupt(pin, false)
+// Lines are shared by the pins of the same number on every port, like STM32 EXTI
+#define gpio_pin_interrupt_line(pin) ((pin)&0xF)
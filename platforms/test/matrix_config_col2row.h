@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 3
+#define MATRIX_COLS 10
+#define DIODE_DIRECTION COL2ROW
+
+// Columns spread over two ports, with a gap
+#define MATRIX_ROW_PINS \
+    { GPIO_MOCK_PIN(0, 0), GPIO_MOCK_PIN(0, 1), GPIO_MOCK_PIN(0, 2) }
+#define MATRIX_COL_PINS \
+    { GPIO_MOCK_PIN(1, 0), GPIO_MOCK_PIN(1, 1), GPIO_MOCK_PIN(1, 2), GPIO_MOCK_PIN(1, 3), GPIO_MOCK_PIN(1, 4), GPIO_MOCK_PIN(2, 8), GPIO_MOCK_PIN(2, 9), NO_PIN, GPIO_MOCK_PIN(2, 15), GPIO_MOCK_PIN(1, 7) }
+
+#define MATRIX_TEST_INPUT_PORTS 2
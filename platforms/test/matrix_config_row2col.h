@@ -0,0 +1,15 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 6
+#define MATRIX_COLS 18
+#define DIODE_DIRECTION ROW2COL
+
+#define MATRIX_ROW_PINS \
+    { GPIO_MOCK_PIN(3, 0), GPIO_MOCK_PIN(3, 1), GPIO_MOCK_PIN(3, 2), GPIO_MOCK_PIN(3, 3), GPIO_MOCK_PIN(3, 4), GPIO_MOCK_PIN(3, 5) }
+#define MATRIX_COL_PINS \
+    { GPIO_MOCK_PIN(4, 0), GPIO_MOCK_PIN(4, 1), GPIO_MOCK_PIN(4, 2), GPIO_MOCK_PIN(4, 3), GPIO_MOCK_PIN(4, 4), GPIO_MOCK_PIN(4, 5), GPIO_MOCK_PIN(4, 6), GPIO_MOCK_PIN(4, 7), GPIO_MOCK_PIN(4, 8), GPIO_MOCK_PIN(4, 9), GPIO_MOCK_PIN(4, 10), GPIO_MOCK_PIN(4, 11), GPIO_MOCK_PIN(4, 12), GPIO_MOCK_PIN(4, 13), GPIO_MOCK_PIN(4, 14), GPIO_MOCK_PIN(4, 15), GPIO_MOCK_PIN(5, 0), GPIO_MOCK_PIN(5, 1) }
+
+#define MATRIX_TEST_INPUT_PORTS 1
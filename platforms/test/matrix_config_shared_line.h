@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 3
+#define MATRIX_COLS 4
+#define DIODE_DIRECTION COL2ROW
+
+// B1 and C1 share interrupt line 1
+#define MATRIX_ROW_PINS \
+    { GPIO_MOCK_PIN(0, 0), GPIO_MOCK_PIN(0, 1), GPIO_MOCK_PIN(0, 2) }
+#define MATRIX_COL_PINS \
+    { GPIO_MOCK_PIN(1, 0), GPIO_MOCK_PIN(1, 1), GPIO_MOCK_PIN(2, 1), GPIO_MOCK_PIN(2, 3) }
+
+#define MATRIX_TEST_INPUT_PORTS 2
+#define MATRIX_TEST_SHARED_INTERRUPT_LINE
@@ -0,0 +1,183 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+}
+
+extern "C" {
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+void matrix_output_select_delay(void) {}
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
+void matrix_init_kb(void) {}
+void matrix_scan_kb(void) {}
+}
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static uint8_t connected_pins(const pin_t pins[], uint8_t count) {
+    uint8_t connected = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        connected += pins[i] != NO_PIN;
+    }
+    return connected;
+}
+
+#if (DIODE_DIRECTION == COL2ROW)
+#    define STROBE_COUNT connected_pins(row_pins, MATRIX_ROWS)
+#    define INPUT_COUNT connected_pins(col_pins, MATRIX_COLS)
+#else
+#    define STROBE_COUNT connected_pins(col_pins, MATRIX_COLS)
+#    define INPUT_COUNT connected_pins(row_pins, MATRIX_ROWS)
+#endif
+
+class Matrix : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        gpio_mock_reset();
+        matrix_init();
+    }
+
+    void set_key(uint8_t row, uint8_t col, bool pressed) {
+        if (row_pins[row] != NO_PIN && col_pins[col] != NO_PIN) {
+            gpio_mock_set_switch(row_pins[row], col_pins[col], pressed);
+        }
+    }
+
+    void expect_matrix(const matrix_row_t expected[MATRIX_ROWS]) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix[row], expected[row]) << "row " << (int)row;
+        }
+    }
+};
+
+TEST_F(Matrix, NoKeysPressed) {
+    matrix_row_t expected[MATRIX_ROWS] = {0};
+
+    matrix_scan();
+    expect_matrix(expected);
+}
+
+TEST_F(Matrix, EverySingleKey) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t expected[MATRIX_ROWS] = {0};
+            if (col_pins[col] != NO_PIN) {
+                expected[row] = (matrix_row_t)1 << col;
+            }
+
+            set_key(row, col, true);
+            matrix_scan();
+            expect_matrix(expected);
+
+            set_key(row, col, false);
+        }
+    }
+}
+
+TEST_F(Matrix, MultipleKeys) {
+    matrix_row_t expected[MATRIX_ROWS] = {0};
+
+    // The mock has diodes on every key, so three corners of a rectangle do not ghost the fourth
+    set_key(0, 0, true);
+    set_key(0, MATRIX_COLS - 1, true);
+    set_key(MATRIX_ROWS - 1, 0, true);
+    set_key(1, 8, true);
+    expected[0]               = ((matrix_row_t)1 << 0) | ((matrix_row_t)1 << (MATRIX_COLS - 1));
+    expected[MATRIX_ROWS - 1] = (matrix_row_t)1 << 0;
+    expected[1] |= (matrix_row_t)1 << 8;
+
+    EXPECT_TRUE(matrix_scan());
+    expect_matrix(expected);
+
+    EXPECT_FALSE(matrix_scan());
+    expect_matrix(expected);
+}
+
+TEST_F(Matrix, PinAccessesPerScan) {
+    matrix_scan();
+
+#ifdef MATRIX_PORT_SCAN
+    // Every strobe reads each input port once
+    EXPECT_EQ(gpio_mock_port_reads(), STROBE_COUNT * MATRIX_TEST_INPUT_PORTS);
+    EXPECT_EQ(gpio_mock_pin_reads(), 0);
+#else
+    EXPECT_EQ(gpio_mock_port_reads(), 0);
+    EXPECT_EQ(gpio_mock_pin_reads(), STROBE_COUNT * INPUT_COUNT);
+#endif
+}
+
+#ifdef MATRIX_WAKE_ON_CHANGE
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define INPUT_PINS col_pins
+#        define INPUT_PIN_COUNT MATRIX_COLS
+#    else
+#        define INPUT_PINS row_pins
+#        define INPUT_PIN_COUNT MATRIX_ROWS
+#    endif
+
+#    ifdef MATRIX_TEST_SHARED_INTERRUPT_LINE
+TEST_F(Matrix, KeepsScanningWhenInputsShareInterruptLine) {
+    EXPECT_FALSE(matrix_scan());
+    EXPECT_FALSE(matrix_is_waiting_for_change());
+    for (uint8_t i = 0; i < INPUT_PIN_COUNT; i++) {
+        EXPECT_FALSE(gpio_mock_pin_interrupt_enabled(INPUT_PINS[i])) << "input " << (int)i;
+    }
+
+    set_key(2, 2, true);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[2], (matrix_row_t)1 << 2);
+}
+#    else
+TEST_F(Matrix, IdleScanOnlyReadsInputs) {
+    matrix_scan();
+    EXPECT_TRUE(matrix_is_waiting_for_change());
+    for (uint8_t i = 0; i < INPUT_PIN_COUNT; i++) {
+        if (INPUT_PINS[i] != NO_PIN) {
+            EXPECT_TRUE(gpio_mock_pin_interrupt_enabled(INPUT_PINS[i])) << "input " << (int)i;
+        }
+    }
+
+    uint32_t pin_reads  = gpio_mock_pin_reads();
+    uint32_t port_reads = gpio_mock_port_reads();
+    EXPECT_FALSE(matrix_scan());
+
+#    ifdef MATRIX_PORT_SCAN
+    EXPECT_EQ(gpio_mock_port_reads() - port_reads, MATRIX_TEST_INPUT_PORTS);
+    EXPECT_EQ(gpio_mock_pin_reads() - pin_reads, 0);
+#    else
+    EXPECT_EQ(gpio_mock_port_reads() - port_reads, 0);
+    EXPECT_EQ(gpio_mock_pin_reads() - pin_reads, INPUT_COUNT);
+#    endif
+}
+
+TEST_F(Matrix, KeyPressResumesScanning) {
+    matrix_scan();
+    EXPECT_TRUE(matrix_is_waiting_for_change());
+
+    set_key(1, 2, true);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[1], (matrix_row_t)1 << 2);
+    EXPECT_FALSE(matrix_is_waiting_for_change());
+    for (uint8_t i = 0; i < INPUT_PIN_COUNT; i++) {
+        if (INPUT_PINS[i] != NO_PIN) {
+            EXPECT_FALSE(gpio_mock_pin_interrupt_enabled(INPUT_PINS[i])) << "input " << (int)i;
+        }
+    }
+
+    // Held keys keep the full scan running
+    EXPECT_FALSE(matrix_scan());
+    EXPECT_FALSE(matrix_is_waiting_for_change());
+
+    set_key(1, 2, false);
+    EXPECT_TRUE(matrix_scan());
+    EXPECT_EQ(matrix[1], 0);
+    EXPECT_TRUE(matrix_is_waiting_for_change());
+}
+#    endif
+#endif
@@ -23,3 +23,49 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+ws2812_spi_encoder_INC := \
+	$(PLATFORM_PATH)/chibios/drivers/
+ws2812_spi_encoder_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_spi_encoder_tests.cpp
+
+ws2812_spi_encoder_rgbw_DEFS := \
+	-DRGBW \
+	-DWS2812_BYTE_ORDER=WS2812_BYTE_ORDER_RGB
+ws2812_spi_encoder_rgbw_INC := $(ws2812_spi_encoder_INC)
+ws2812_spi_encoder_rgbw_SRC := $(ws2812_spi_encoder_SRC)
+
+matrix_DEFS := -DGPIO_MOCK -DIGNORE_ATOMIC_BLOCK
+matrix_SRC := \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/gpio_mock.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_tests.cpp
+
+matrix_pin_scan_col2row_DEFS := $(matrix_DEFS)
+matrix_pin_scan_col2row_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_col2row.h
+matrix_pin_scan_col2row_SRC := $(matrix_SRC)
+
+matrix_pin_scan_row2col_DEFS := $(matrix_DEFS)
+matrix_pin_scan_row2col_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_row2col.h
+matrix_pin_scan_row2col_SRC := $(matrix_SRC)
+
+matrix_port_scan_col2row_DEFS := $(matrix_DEFS) -DMATRIX_PORT_SCAN
+matrix_port_scan_col2row_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_col2row.h
+matrix_port_scan_col2row_SRC := $(matrix_SRC)
+
+matrix_port_scan_row2col_DEFS := $(matrix_DEFS) -DMATRIX_PORT_SCAN
+matrix_port_scan_row2col_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_row2col.h
+matrix_port_scan_row2col_SRC := $(matrix_SRC)
+
+matrix_wake_col2row_DEFS := $(matrix_DEFS) -DMATRIX_WAKE_ON_CHANGE
+matrix_wake_col2row_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_col2row.h
+matrix_wake_col2row_SRC := $(matrix_SRC)
+
+matrix_wake_row2col_DEFS := $(matrix_DEFS) -DMATRIX_WAKE_ON_CHANGE -DMATRIX_PORT_SCAN
+matrix_wake_row2col_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_row2col.h
+matrix_wake_row2col_SRC := $(matrix_SRC)
+
+matrix_wake_shared_line_DEFS := $(matrix_DEFS) -DMATRIX_WAKE_ON_CHANGE
+matrix_wake_shared_line_CONFIG := $(PLATFORM_PATH)/$(PLATFORM_KEY)/matrix_config_shared_line.h
+matrix_wake_shared_line_SRC := $(matrix_SRC)
@@ -1 +1,3 @@
 TEST_LIST += eeprom_legacy_emulated_flash_tiny eeprom_legacy_emulated_flash_large
+TEST_LIST += ws2812_spi_encoder ws2812_spi_encoder_rgbw
+TEST_LIST += matrix_pin_scan_col2row matrix_pin_scan_row2col matrix_port_scan_col2row matrix_port_scan_row2col matrix_wake_col2row matrix_wake_row2col matrix_wake_shared_line
@@ -0,0 +1,96 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_spi_encoder.h"
+}
+
+// The bit by bit encoder the lookup table replaced
+static uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+static void reference_encode_byte(uint8_t *dst, uint8_t data) {
+    for (int j = 0; j < 4; j++) {
+        dst[j] = get_protocol_eq(data, j);
+    }
+}
+
+static void reference_encode_led(uint8_t *dst, rgb_led_t color) {
+#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
+    reference_encode_byte(dst, color.g);
+    reference_encode_byte(dst + 4, color.r);
+    reference_encode_byte(dst + 8, color.b);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
+    reference_encode_byte(dst, color.r);
+    reference_encode_byte(dst + 4, color.g);
+    reference_encode_byte(dst + 8, color.b);
+#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
+    reference_encode_byte(dst, color.b);
+    reference_encode_byte(dst + 4, color.g);
+    reference_encode_byte(dst + 8, color.r);
+#endif
+#ifdef RGBW
+    reference_encode_byte(dst + 12, color.w);
+#endif
+}
+
+TEST(WS2812SpiEncoder, EncodesEveryByteLikeTheReference) {
+    for (int data = 0; data < 256; data++) {
+        uint8_t expected[WS2812_SPI_BYTES_PER_BYTE];
+        uint8_t actual[WS2812_SPI_BYTES_PER_BYTE];
+
+        reference_encode_byte(expected, data);
+        ws2812_spi_encode_byte(actual, data);
+
+        EXPECT_EQ(memcmp(expected, actual, sizeof(actual)), 0) << "byte " << data;
+    }
+}
+
+TEST(WS2812SpiEncoder, EncodesBitPairsMostSignificantFirst) {
+    uint8_t actual[WS2812_SPI_BYTES_PER_BYTE];
+
+    ws2812_spi_encode_byte(actual, 0b10011100);
+
+    EXPECT_EQ(actual[0], 0b11101000);
+    EXPECT_EQ(actual[1], 0b10001110);
+    EXPECT_EQ(actual[2], 0b11101110);
+    EXPECT_EQ(actual[3], 0b10001000);
+}
+
+TEST(WS2812SpiEncoder, EncodesFrameLikeTheReference) {
+    rgb_led_t leds[64];
+    uint8_t   expected[64 * WS2812_SPI_BYTES_PER_LED + 1];
+    uint8_t   actual[64 * WS2812_SPI_BYTES_PER_LED + 1];
+
+    for (int i = 0; i < 64; i++) {
+        leds[i].r = i * 4;
+        leds[i].g = 255 - i;
+        leds[i].b = i * 37;
+#ifdef RGBW
+        leds[i].w = i ^ 0x5A;
+#endif
+    }
+
+    // The last byte catches LEDs encoded past their own slot
+    memset(expected, 0, sizeof(expected));
+    memset(actual, 0, sizeof(actual));
+    for (int i = 0; i < 64; i++) {
+        reference_encode_led(&expected[i * WS2812_SPI_BYTES_PER_LED], leds[i]);
+        ws2812_spi_encode_led(&actual[i * WS2812_SPI_BYTES_PER_LED], leds[i]);
+    }
+
+    EXPECT_EQ(memcmp(expected, actual, sizeof(actual)), 0);
+    EXPECT_EQ(actual[64 * WS2812_SPI_BYTES_PER_LED], 0);
+}
@@ -40,6 +40,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "pointing_device.h"
 #endif
 
+#ifdef LATENCY_TRACKER_ENABLE
+#    include "latency_tracker.h"
+#endif
+
 #if defined(ENCODER_ENABLE) && defined(ENCODER_MAP_ENABLE) && defined(SWAP_HANDS_ENABLE)
 #    include "encoder.h"
 #endif
@@ -262,15 +266,7 @@ void process_record_tap_hint(keyrecord_t *record) {
 }
 #endif
 
-/** \brief Take a key event (key press or key release) and processes it.
- *
- * FIXME: Needs documentation.
- */
-void process_record(keyrecord_t *record) {
-    if (IS_NOEVENT(record->event)) {
-        return;
-    }
-
+static void process_record_dispatch(keyrecord_t *record) {
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && keymap_config.oneshot_enable) {
@@ -284,6 +280,24 @@ void process_record(keyrecord_t *record) {
     post_process_record_quantum(record);
 }
 
+/** \brief Take a key event (key press or key release) and processes it.
+ *
+ * FIXME: Needs documentation.
+ */
+void process_record(keyrecord_t *record) {
+    if (IS_NOEVENT(record->event)) {
+        return;
+    }
+
+#ifdef LATENCY_TRACKER_ENABLE
+    latency_tracker_event_begin(record->event);
+#endif
+    process_record_dispatch(record);
+#ifdef LATENCY_TRACKER_ENABLE
+    latency_tracker_event_end();
+#endif
+}
+
 void process_record_handler(keyrecord_t *record) {
 #if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
     action_t action;
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,16 +317,34 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief layer lookup cache
  *
- * Gets the layer based on key info
+ * Resolved source layer per matrix position, valid for the layer state in
+ * layer_lookup_cache_layers. Entries are computed lazily on lookup.
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+static uint8_t       layer_lookup_cache[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t       layer_lookup_cache_valid[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)];
+static layer_state_t layer_lookup_cache_layers = 0;
+
+/** \brief Layer lookup cache clear
+ *
+ * Drops all resolved layers, e.g. after the keymap has been changed at runtime.
+ */
+void layer_lookup_cache_clear(void) {
+    memset(layer_lookup_cache_valid, 0, sizeof(layer_lookup_cache_valid));
+}
+#endif
+
 #ifndef NO_ACTION_LAYER
+/** \brief Layer switch find layer
+ *
+ * Finds the topmost layer in layers with a non-transparent action for key
+ */
+static uint8_t layer_switch_find_layer(keypos_t key, layer_state_t layers) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +356,36 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+
+#    ifdef LAYER_LOOKUP_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+        const uint16_t storage_idx  = entry_number / (CHAR_BIT);
+        const uint8_t  storage_bit  = 1U << (entry_number % (CHAR_BIT));
+
+        if (layers != layer_lookup_cache_layers) {
+            layer_lookup_cache_clear();
+            layer_lookup_cache_layers = layers;
+        }
+        if (!(layer_lookup_cache_valid[storage_idx] & storage_bit)) {
+            layer_lookup_cache[entry_number] = layer_switch_find_layer(key, layers);
+            layer_lookup_cache_valid[storage_idx] |= storage_bit;
+        }
+        return layer_lookup_cache[entry_number];
+    }
+#    endif
+
+    return layer_switch_find_layer(key, layers);
 #else
     return get_highest_layer(default_layer_state);
 #endif
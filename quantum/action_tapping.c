@@ -157,6 +157,21 @@ void action_tapping_process(keyrecord_t record) {
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS false
 #    endif
 
+/** \brief Action Tapping Idle Time
+ *
+ * Number of milliseconds until a tick event can change the tapping state, or
+ * IDLE_TIME_FOREVER if no tapping key is being processed.
+ */
+uint32_t action_tapping_idle_time(void) {
+    if (IS_NOEVENT(tapping_key.event)) {
+        return IDLE_TIME_FOREVER;
+    }
+
+    const uint16_t term    = GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key);
+    const uint16_t elapsed = TIMER_DIFF_16(timer_read(), tapping_key.event.time);
+    return elapsed < term ? term - elapsed : 0;
+}
+
 /** \brief Tapping
  *
  * Rule: Tap key is typed(pressed and released) within TAPPING_TERM.
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_layer.h"
 #include "timer.h"
 #include "keycode_config.h"
+#include "keyboard.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -121,6 +122,16 @@ static uint16_t oneshot_swaphands_time = 0;
 inline bool     has_oneshot_swaphands_timed_out(void) {
     return TIMER_DIFF_16(timer_read(), oneshot_swaphands_time) >= ONESHOT_TIMEOUT && (swap_hands_oneshot == SHO_ACTIVE);
 }
+
+/** \brief Milliseconds until the one shot swap hands times out, IDLE_TIME_FOREVER if it isn't waiting for a key
+ */
+uint32_t oneshot_swaphands_idle_time(void) {
+    if (swap_hands_oneshot != SHO_ACTIVE) {
+        return IDLE_TIME_FOREVER;
+    }
+    const uint16_t elapsed = TIMER_DIFF_16(timer_read(), oneshot_swaphands_time);
+    return elapsed < ONESHOT_TIMEOUT ? ONESHOT_TIMEOUT - elapsed : 0;
+}
 #        endif
 #    endif
 
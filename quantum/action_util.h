@@ -103,6 +103,9 @@ void set_oneshot_swaphands(void);
 void release_oneshot_swaphands(void);
 void use_oneshot_swaphands(void);
 void clear_oneshot_swaphands(void);
+#    if (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+uint32_t oneshot_swaphands_idle_time(void);
+#    endif
 #endif
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
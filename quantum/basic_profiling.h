@@ -4,6 +4,7 @@
 
 /*
     This API allows for basic profiling information to be printed out over console.
+    For per-task statistics of the main loop, see PROFILING_ENABLE in profiling.h instead.
 
     Usage example:
 
@@ -21,7 +22,10 @@
         });
 */
 
-#if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
+#if defined(PROFILING_ENABLE)
+#    include "profiling.h"
+#    define TIMESTAMP_GETTER profiling_timestamp()
+#elif defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
 #    define TIMESTAMP_GETTER TCNT0
 #elif defined(PROTOCOL_CHIBIOS)
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
@@ -0,0 +1,92 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Asymetric per-key algorithm, with the same behaviour as asym_eager_defer_pk.
+After pressing a key, it immediately changes state, with no further inputs
+accepted until DEBOUNCE milliseconds have occurred. After releasing a key, that
+state is pushed after no changes occur for DEBOUNCE milliseconds.
+
+The counters are vertical counters (see vertical_counter.h), so each row is
+processed with bitwise operations instead of a loop over its keys.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 127ms
+#if DEBOUNCE > 127
+#    undef DEBOUNCE
+#    define DEBOUNCE 127
+#endif
+
+#if DEBOUNCE > 0
+#    include "debounce_common.h"
+#    include "vertical_counter.h"
+
+static debounce_vc_t debounce_counters[MATRIX_ROWS];
+static matrix_row_t  debounce_pressed[MATRIX_ROWS];
+
+static void init_debounce_counters(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+    memset(debounce_pressed, 0, sizeof(debounce_pressed));
+}
+
+static void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t expired = debounce_vc_elapse(&debounce_counters[row], elapsed_time);
+
+        if (expired) {
+            // key-down: eager
+            if (expired & debounce_pressed[row]) {
+                matrix_need_update = true;
+            }
+
+            // key-up: defer
+            matrix_row_t released    = expired & ~debounce_pressed[row];
+            matrix_row_t cooked_next = (cooked[row] & ~released) | (raw[row] & released);
+            cooked_changed |= cooked_next ^ cooked[row];
+            cooked[row] = cooked_next;
+        }
+        if (debounce_vc_active(&debounce_counters[row])) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_need_update = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta  = raw[row] ^ cooked[row];
+        matrix_row_t active = debounce_vc_active(&debounce_counters[row]);
+        matrix_row_t start  = delta & ~active;
+
+        // key-up: defer, restarted by the next change
+        debounce_vc_clear(&debounce_counters[row], ~delta & active & ~debounce_pressed[row]);
+
+        if (start) {
+            debounce_pressed[row] = (debounce_pressed[row] & ~start) | (raw[row] & start);
+            debounce_vc_start(&debounce_counters[row], start);
+            counters_need_update = true;
+
+            // key-down: eager
+            if (start & raw[row]) {
+                cooked[row] ^= start & raw[row];
+                cooked_changed = true;
+            }
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
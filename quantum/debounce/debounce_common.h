@@ -0,0 +1,73 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Timer bookkeeping shared by the counter based debounce algorithms.
+
+This provides debounce_init(), debounce_free() and debounce(). Include it once
+from the algorithm, after DEBOUNCE is set, and implement:
+
+  init_debounce_counters()     reset the counters to elapsed
+  update_debounce_counters()   count down by elapsed_time, which is never 0;
+                               only called while counters_need_update is set
+  transfer_matrix_values()     apply raw to cooked; called when raw changed,
+                               or while matrix_need_update is set
+
+The counters are statically allocated by the algorithm, for MATRIX_ROWS rows,
+so none of the algorithms need a heap.
+*/
+
+#pragma once
+
+#include "debounce.h"
+#include "timer.h"
+
+#define DEBOUNCE_ELAPSED 0
+
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         matrix_need_update;
+static bool         cooked_changed;
+
+static void init_debounce_counters(uint8_t num_rows);
+static void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+    init_debounce_counters(num_rows);
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
@@ -19,7 +19,7 @@ DEBOUNCE milliseconds have elapsed since the last change.
 
 #include "debounce.h"
 #include "timer.h"
-#include <stdlib.h>
+#include <string.h>
 
 #ifndef DEBOUNCE
 #    define DEBOUNCE 5
@@ -27,23 +27,18 @@ DEBOUNCE milliseconds have elapsed since the last change.
 
 static uint16_t last_time;
 // [row] milliseconds until key's state is considered debounced.
-static uint8_t* countdowns;
+static uint8_t countdowns[MATRIX_ROWS];
 // [row]
-static matrix_row_t* last_raw;
+static matrix_row_t last_raw[MATRIX_ROWS];
 
 void debounce_init(uint8_t num_rows) {
-    countdowns = (uint8_t*)calloc(num_rows, sizeof(uint8_t));
-    last_raw   = (matrix_row_t*)calloc(num_rows, sizeof(matrix_row_t));
+    memset(countdowns, 0, sizeof(countdowns));
+    memset(last_raw, 0, sizeof(last_raw));
 
     last_time = timer_read();
 }
 
-void debounce_free(void) {
-    free(countdowns);
-    countdowns = NULL;
-    free(last_raw);
-    last_raw = NULL;
-}
+void debounce_free(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
     uint16_t now           = timer_read();
@@ -0,0 +1,67 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Symmetric per-key algorithm, with the same behaviour as sym_defer_pk.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+The counters are vertical counters (see vertical_counter.h), so each row is
+processed with bitwise operations instead of a loop over its keys.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+#    include "debounce_common.h"
+#    include "vertical_counter.h"
+
+static debounce_vc_t debounce_counters[MATRIX_ROWS];
+
+static void init_debounce_counters(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+}
+
+static void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t expired = debounce_vc_elapse(&debounce_counters[row], elapsed_time);
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+        if (debounce_vc_active(&debounce_counters[row])) {
+            counters_need_update = true;
+        }
+    }
+}
+
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        matrix_row_t start = delta & ~debounce_vc_active(&debounce_counters[row]);
+
+        debounce_vc_clear(&debounce_counters[row], ~delta);
+        if (start) {
+            debounce_vc_start(&debounce_counters[row], start);
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
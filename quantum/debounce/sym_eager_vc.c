@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Symmetric per-key algorithm, with the same behaviour as sym_eager_pk.
+After pressing a key, it immediately changes state, and sets a counter.
+No further inputs are accepted until DEBOUNCE milliseconds have occurred.
+
+The counters are vertical counters (see vertical_counter.h), so each row is
+processed with bitwise operations instead of a loop over its keys.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+#    include "debounce_common.h"
+#    include "vertical_counter.h"
+
+static debounce_vc_t debounce_counters[MATRIX_ROWS];
+
+static void init_debounce_counters(uint8_t num_rows) {
+    memset(debounce_counters, 0, sizeof(debounce_counters));
+}
+
+// If the current time is > debounce counter, set the counter to enable input.
+static void update_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        if (debounce_vc_elapse(&debounce_counters[row], elapsed_time)) {
+            matrix_need_update = true;
+        }
+        if (debounce_vc_active(&debounce_counters[row])) {
+            counters_need_update = true;
+        }
+    }
+}
+
+// upload from raw_matrix to final matrix;
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    matrix_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        matrix_row_t start = delta & ~debounce_vc_active(&debounce_counters[row]);
+
+        if (start) {
+            debounce_vc_start(&debounce_counters[row], start);
+            counters_need_update = true;
+            cooked[row] ^= start; // flip the bits.
+            cooked_changed = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Builds one of the per-key algorithms under other names, to compare its vertical counter variant against it
+#define debounce_init debounce_reference_init
+#define debounce_free debounce_reference_free
+#define debounce debounce_reference
+
+#if defined(DEBOUNCE_REFERENCE_SYM_DEFER_PK)
+#    include "../sym_defer_pk.c"
+#elif defined(DEBOUNCE_REFERENCE_SYM_EAGER_PK)
+#    include "../sym_eager_pk.c"
+#elif defined(DEBOUNCE_REFERENCE_ASYM_EAGER_DEFER_PK)
+#    include "../asym_eager_defer_pk.c"
+#else
+#    error No reference debounce algorithm selected
+#endif
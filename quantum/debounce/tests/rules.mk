@@ -52,3 +52,24 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_sym_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE_SYM_DEFER_PK
+debounce_sym_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/vertical_counter_tests.cpp
+
+debounce_sym_eager_vc_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE_SYM_EAGER_PK
+debounce_sym_eager_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/vertical_counter_tests.cpp
+
+debounce_asym_eager_defer_vc_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_REFERENCE_ASYM_EAGER_DEFER_PK
+debounce_asym_eager_defer_vc_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/asym_eager_defer_vc.c \
+	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/debounce_reference.c \
+	$(QUANTUM_PATH)/debounce/tests/vertical_counter_tests.cpp
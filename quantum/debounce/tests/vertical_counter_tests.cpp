@@ -0,0 +1,132 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+void simulate_async_tick(uint32_t t);
+
+void debounce_reference_init(uint8_t num_rows);
+void debounce_reference_free(void);
+bool debounce_reference(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+}
+
+#define ALL_COLS ((matrix_row_t)((1ULL << MATRIX_COLS) - 1))
+
+class DebounceVerticalCounter : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        srand(1);
+        set_time(7777);
+        simulate_async_tick(0);
+        debounce_init(MATRIX_ROWS);
+        debounce_reference_init(MATRIX_ROWS);
+        memset(raw_, 0, sizeof(raw_));
+        memset(cooked_, 0, sizeof(cooked_));
+        memset(cooked_reference_, 0, sizeof(cooked_reference_));
+    }
+
+    void TearDown() override {
+        debounce_free();
+        debounce_reference_free();
+    }
+
+    // Toggle a few random keys, each with the given chance out of 1000
+    bool bounce(int chance) {
+        bool changed = false;
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            for (int col = 0; col < MATRIX_COLS; col++) {
+                if (rand() % 1000 < chance) {
+                    raw_[row] ^= (matrix_row_t)1 << col;
+                    changed = true;
+                }
+            }
+        }
+        return changed;
+    }
+
+    matrix_row_t raw_[MATRIX_ROWS];
+    matrix_row_t cooked_[MATRIX_ROWS];
+    matrix_row_t cooked_reference_[MATRIX_ROWS];
+};
+
+TEST_F(DebounceVerticalCounter, MatchesPerKeyAlgorithm) {
+    for (int step = 0; step < 200000; step++) {
+        // Mostly scan faster than 1kHz, with the occasional stall well past DEBOUNCE
+        int r = rand() % 100;
+        if (r < 2) {
+            advance_time(DEBOUNCE + rand() % 300);
+        } else if (r < 60) {
+            advance_time(rand() % 3);
+        }
+
+        // Alternate between chattering and quiet stretches, so counters both restart and elapse
+        bool changed = bounce((step / 500) % 2 ? 2 : 40);
+
+        bool cooked_changed           = debounce(raw_, cooked_, MATRIX_ROWS, changed);
+        bool cooked_changed_reference = debounce_reference(raw_, cooked_reference_, MATRIX_ROWS, changed);
+
+        ASSERT_EQ(cooked_changed, cooked_changed_reference) << "at step " << step;
+        for (int row = 0; row < MATRIX_ROWS; row++) {
+            ASSERT_EQ(cooked_[row], cooked_reference_[row]) << "row " << row << " at step " << step;
+        }
+    }
+}
+
+TEST_F(DebounceVerticalCounter, CountsDownLargeElapsedTimes) {
+    raw_[0] = ALL_COLS;
+    debounce(raw_, cooked_, MATRIX_ROWS, true);
+    debounce_reference(raw_, cooked_reference_, MATRIX_ROWS, true);
+
+    advance_time(UINT16_MAX);
+    debounce(raw_, cooked_, MATRIX_ROWS, false);
+    debounce_reference(raw_, cooked_reference_, MATRIX_ROWS, false);
+
+    EXPECT_EQ(cooked_[0], ALL_COLS);
+    EXPECT_EQ(cooked_[0], cooked_reference_[0]);
+}
+
+// Not a pass/fail test: reports the cost of one scan on the host for both algorithms
+TEST_F(DebounceVerticalCounter, Benchmark) {
+    const int                 iterations = 100000;
+    std::vector<matrix_row_t> inputs(iterations * MATRIX_ROWS);
+    std::vector<bool>         changes(iterations);
+
+    for (int step = 0; step < iterations; step++) {
+        changes[step] = bounce(20);
+        memcpy(&inputs[step * MATRIX_ROWS], raw_, sizeof(raw_));
+    }
+
+    // Timings are reported as test properties, --gtest_output=json:<file> collects them
+    for (int pass = 0; pass < 2; pass++) {
+        bool (*algorithm)(matrix_row_t[], matrix_row_t[], uint8_t, bool) = pass ? debounce_reference : debounce;
+
+        set_time(7777);
+        matrix_row_t *cooked = pass ? cooked_reference_ : cooked_;
+        memset(cooked, 0, sizeof(cooked_));
+
+        auto start = std::chrono::steady_clock::now();
+        for (int step = 0; step < iterations; step++) {
+            advance_time(step & 1);
+            algorithm(&inputs[step * MATRIX_ROWS], cooked, MATRIX_ROWS, changes[step]);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        RecordProperty(pass ? "per_key.ns_per_scan" : "vertical_counter.ns_per_scan", std::to_string(elapsed.count() / iterations));
+    }
+
+    // Both ran on the same input, so the timings compare the same work
+    for (int row = 0; row < MATRIX_ROWS; row++) {
+        EXPECT_EQ(cooked_[row], cooked_reference_[row]) << "row " << row;
+    }
+}
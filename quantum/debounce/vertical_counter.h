@@ -0,0 +1,102 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Vertical counters for the per-key debounce algorithms.
+
+Instead of one byte counter per key, the counters of a whole row are stored as
+bit planes: bit N of plane B is bit B of the counter for column N. Loading,
+clearing and decrementing the counters of every key in a row then takes a fixed
+number of bitwise operations per plane, independent of MATRIX_COLS.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include "matrix.h"
+
+// Number of bit planes needed to hold DEBOUNCE
+#if DEBOUNCE < 2
+#    define DEBOUNCE_VC_BITS 1
+#elif DEBOUNCE < 4
+#    define DEBOUNCE_VC_BITS 2
+#elif DEBOUNCE < 8
+#    define DEBOUNCE_VC_BITS 3
+#elif DEBOUNCE < 16
+#    define DEBOUNCE_VC_BITS 4
+#elif DEBOUNCE < 32
+#    define DEBOUNCE_VC_BITS 5
+#elif DEBOUNCE < 64
+#    define DEBOUNCE_VC_BITS 6
+#elif DEBOUNCE < 128
+#    define DEBOUNCE_VC_BITS 7
+#else
+#    define DEBOUNCE_VC_BITS 8
+#endif
+
+typedef struct {
+    matrix_row_t plane[DEBOUNCE_VC_BITS];
+} debounce_vc_t;
+
+// Columns with a counter that has not yet elapsed
+static inline matrix_row_t debounce_vc_active(const debounce_vc_t *vc) {
+    matrix_row_t active = 0;
+    for (uint8_t i = 0; i < DEBOUNCE_VC_BITS; i++) {
+        active |= vc->plane[i];
+    }
+    return active;
+}
+
+// Set the counters of the columns in mask to DEBOUNCE
+static inline void debounce_vc_start(debounce_vc_t *vc, matrix_row_t mask) {
+    for (uint8_t i = 0; i < DEBOUNCE_VC_BITS; i++) {
+        if ((DEBOUNCE >> i) & 1) {
+            vc->plane[i] |= mask;
+        } else {
+            vc->plane[i] &= ~mask;
+        }
+    }
+}
+
+// Set the counters of the columns in mask to elapsed
+static inline void debounce_vc_clear(debounce_vc_t *vc, matrix_row_t mask) {
+    for (uint8_t i = 0; i < DEBOUNCE_VC_BITS; i++) {
+        vc->plane[i] &= ~mask;
+    }
+}
+
+/**
+ * \brief Subtract elapsed_time from every active counter.
+ *
+ * Counters that are less than or equal to elapsed_time are set to elapsed.
+ *
+ * \return The columns with a counter that elapsed.
+ */
+static inline matrix_row_t debounce_vc_elapse(debounce_vc_t *vc, uint8_t elapsed_time) {
+    matrix_row_t active = debounce_vc_active(vc);
+
+    if (elapsed_time >= (1U << DEBOUNCE_VC_BITS)) {
+        debounce_vc_clear(vc, active);
+        return active;
+    }
+
+    // Ripple borrow subtraction of the same value from every column
+    matrix_row_t borrow    = 0;
+    matrix_row_t remaining = 0;
+    for (uint8_t i = 0; i < DEBOUNCE_VC_BITS; i++) {
+        matrix_row_t a = vc->plane[i];
+        matrix_row_t b = ((elapsed_time >> i) & 1) ? ~(matrix_row_t)0 : 0;
+
+        vc->plane[i] = a ^ b ^ borrow;
+        borrow       = (~a & b) | (~(a ^ b) & borrow);
+        remaining |= vc->plane[i];
+    }
+
+    // Columns that went below zero or reached it, including inactive ones that wrapped around
+    matrix_row_t keep = remaining & ~borrow;
+    for (uint8_t i = 0; i < DEBOUNCE_VC_BITS; i++) {
+        vc->plane[i] &= keep;
+    }
+
+    return active & ~keep;
+}
@@ -12,19 +12,60 @@
 //------------------------------------
 // Helpers
 //
+// Each executor table is kept ordered: the in-use entries are packed at the start of the table, sorted by trigger time, followed by
+// the free entries. This way the task only has to look at the first entry to know whether anything is due.
+//
 
 static deferred_token current_token = 0;
 
+static inline bool executor_in_use(deferred_executor_t *table, size_t table_count, size_t index) {
+    return index < table_count && table[index].token != INVALID_DEFERRED_TOKEN;
+}
+
+static inline bool executor_triggers_before(const deferred_executor_t *a, const deferred_executor_t *b) {
+    return ((int32_t)TIMER_DIFF_32(a->trigger_time, b->trigger_time)) < 0;
+}
+
+static inline int executor_find(deferred_executor_t *table, size_t table_count, deferred_token token) {
+    for (int i = 0; executor_in_use(table, table_count, i); ++i) {
+        if (table[i].token == token) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Moves the entry at the supplied index to the right place after its trigger time was changed
+static void executor_reposition(deferred_executor_t *table, size_t table_count, size_t index) {
+    deferred_executor_t entry = table[index];
+    while (index > 0 && executor_triggers_before(&entry, &table[index - 1])) {
+        table[index] = table[index - 1];
+        --index;
+    }
+    while (executor_in_use(table, table_count, index + 1) && !executor_triggers_before(&entry, &table[index + 1])) {
+        table[index] = table[index + 1];
+        ++index;
+    }
+    table[index] = entry;
+}
+
+// Frees up the entry at the supplied index, moving the following in-use entries down
+static void executor_remove(deferred_executor_t *table, size_t table_count, size_t index) {
+    while (executor_in_use(table, table_count, index + 1)) {
+        table[index] = table[index + 1];
+        ++index;
+    }
+    table[index].token        = INVALID_DEFERRED_TOKEN;
+    table[index].trigger_time = 0;
+    table[index].callback     = NULL;
+    table[index].cb_arg       = NULL;
+}
+
 static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
     if (token == INVALID_DEFERRED_TOKEN) {
         return false;
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
-        }
-    }
-    return true;
+    return executor_find(table, table_count, token) < 0;
 }
 
 static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
@@ -49,27 +90,29 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
+    // Find the first unused slot, dropping out if none were available
+    size_t index = 0;
+    while (executor_in_use(table, table_count, index)) {
+        ++index;
+    }
+    if (index == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
 
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, table_count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry, and move it into place
+    deferred_executor_t *entry = &table[index];
+    entry->token               = token;
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    executor_reposition(table, table_count, index);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +122,15 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    int index = executor_find(table, table_count, token);
+    if (index < 0) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    table[index].trigger_time = timer_read32() + delay_ms;
+    executor_reposition(table, table_count, index);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +140,22 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    int index = executor_find(table, table_count, token);
+    if (index < 0) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    executor_remove(table, table_count, index);
+    return true;
+}
+
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || !executor_in_use(table, table_count, 0)) {
+        return false;
+    }
+    *trigger_time = table[0].trigger_time;
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,35 +165,50 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
-            deferred_token       curr_token = entry->token;
-
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+        // Nothing to do unless the earliest entry is due
+        if (!executor_in_use(table, table_count, 0) || ((int32_t)TIMER_DIFF_32(table[0].trigger_time, now)) > 0) {
+            return;
+        }
 
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
+        // Each executor runs at most once per task invocation, even if it's requeued with a trigger time that has already passed
+        uint8_t executed[(1 << (8 * sizeof(deferred_token))) / 8] = {0};
+        while (true) {
+            // Find the earliest due entry that hasn't run yet -- due entries are all at the start of the table
+            deferred_executor_t *entry = NULL;
+            for (size_t i = 0; executor_in_use(table, table_count, i) && ((int32_t)TIMER_DIFF_32(table[i].trigger_time, now)) <= 0; ++i) {
+                if (!(executed[table[i].token / 8] & (1 << (table[i].token % 8)))) {
+                    entry = &table[i];
+                    break;
                 }
+            }
+            if (!entry) {
+                break;
+            }
 
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
+            deferred_token curr_token = entry->token;
+            executed[curr_token / 8] |= (1 << (curr_token % 8));
+
+            // Invoke the callback and work work out if we should be requeued
+            uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+            // The callback may have added or removed executors, so the entry may have moved. If it's gone, then the callback has
+            // canceled and re-queued. Skip further processing.
+            int index = executor_find(table, table_count, curr_token);
+            if (index < 0) {
+                continue;
+            }
+
+            // Update the trigger time if we have to repeat, otherwise clear it out
+            if (delay_ms > 0) {
+                // Intentionally add just the delay to the existing trigger time -- this ensures the next
+                // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+                // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+                // considerable length of time, then this ensures best-effort timing between invocations.
+                table[index].trigger_time += delay_ms;
+                executor_reposition(table, table_count, index);
+            } else {
+                // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+                executor_remove(table, table_count, index);
             }
         }
     }
@@ -172,6 +230,9 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+bool deferred_exec_next_deadline(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
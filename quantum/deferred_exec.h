@@ -60,6 +60,14 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms);
  */
 bool cancel_deferred_exec(deferred_token token);
 
+/**
+ * Retrieves the trigger time of the next pending deferred execution, allowing the main loop to decide how long it may idle.
+ *
+ * @param trigger_time[out] the trigger time of the earliest pending deferred execution -- equivalent time-space as timer_read32()
+ * @return true if a deferred execution is pending, otherwise false and trigger_time is left untouched
+ */
+bool deferred_exec_next_deadline(uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any deferred executors. Should not be invoked by keyboard/user code.
  */
@@ -73,6 +81,7 @@ void deferred_exec_task(void);
  * @struct Structure for containing self-hosted deferred executor tables.
  * @brief Core-side code can use this to create their own tables without impacting on the use of users' ability to add deferred execution.
  *        Code outside deferred_exec.c should not worry about internals of this struct, and should just allocate the required number in an array.
+ *        The table must be zero-initialised; entries are kept sorted by trigger time, so the task only needs to check the first entry.
  */
 typedef struct deferred_executor_t {
     deferred_token         token;
@@ -110,6 +119,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Retrieves the trigger time of the next pending deferred execution in a custom table.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the trigger time of the earliest pending deferred execution -- equivalent time-space as timer_read32()
+ * @return true if a deferred execution is pending, otherwise false and trigger_time is left untouched
+ */
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
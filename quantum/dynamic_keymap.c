@@ -14,9 +14,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
+#include "keyboard.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
@@ -101,6 +105,30 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_CACHE
+// Number of keymap layers mirrored in RAM. If less than the layer count,
+// layers are loaded on first use and the least recently used one is evicted.
+#    ifndef DYNAMIC_KEYMAP_CACHE_LAYERS
+#        define DYNAMIC_KEYMAP_CACHE_LAYERS DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+#    if DYNAMIC_KEYMAP_CACHE_LAYERS < 1 || DYNAMIC_KEYMAP_CACHE_LAYERS > DYNAMIC_KEYMAP_LAYER_COUNT
+#        error DYNAMIC_KEYMAP_CACHE_LAYERS must be between 1 and DYNAMIC_KEYMAP_LAYER_COUNT
+#    endif
+
+#    define DYNAMIC_KEYMAP_LAYER_SIZE (MATRIX_ROWS * MATRIX_COLS)
+
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_CACHE_LAYERS][DYNAMIC_KEYMAP_LAYER_SIZE];
+#    if DYNAMIC_KEYMAP_CACHE_LAYERS < DYNAMIC_KEYMAP_LAYER_COUNT
+#        define DYNAMIC_KEYMAP_CACHE_SLOT_EMPTY 0xFF
+// Cached layers, most recently used first, and the cache slot holding each of them
+static uint8_t dynamic_keymap_cache_lru_layers[DYNAMIC_KEYMAP_CACHE_LAYERS];
+static uint8_t dynamic_keymap_cache_lru_slots[DYNAMIC_KEYMAP_CACHE_LAYERS];
+#    endif
+#    ifdef ENCODER_MAP_ENABLE
+static uint16_t dynamic_keymap_encoder_cache[DYNAMIC_KEYMAP_LAYER_COUNT][NUM_ENCODERS][NUM_DIRECTIONS];
+#    endif
+#endif // DYNAMIC_KEYMAP_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -110,13 +138,58 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
+#ifdef DYNAMIC_KEYMAP_CACHE
+static void dynamic_keymap_cache_load(uint16_t *cache, uint8_t layer) {
+    // Keycodes are stored big endian, convert them in place after reading the whole layer
+    uint8_t *data = (uint8_t *)cache;
+    eeprom_read_block(data, dynamic_keymap_key_to_eeprom_address(layer, 0, 0), DYNAMIC_KEYMAP_LAYER_SIZE * 2);
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_LAYER_SIZE; i++) {
+        cache[i] = ((uint16_t)data[i * 2] << 8) | data[i * 2 + 1];
+    }
+}
+
+/* Returns the cached keycodes of a layer, loading it from EEPROM when `load` is set.
+ * Returns NULL if the layer isn't cached and `load` is not set. */
+static uint16_t *dynamic_keymap_cache_get_layer(uint8_t layer, bool load) {
+#    if DYNAMIC_KEYMAP_CACHE_LAYERS < DYNAMIC_KEYMAP_LAYER_COUNT
+    uint8_t i = 0;
+    while (i < DYNAMIC_KEYMAP_CACHE_LAYERS - 1 && dynamic_keymap_cache_lru_layers[i] != layer) {
+        i++;
+    }
+    if (dynamic_keymap_cache_lru_layers[i] != layer) {
+        if (!load) {
+            return NULL;
+        }
+        // Reuse the least recently used slot
+        dynamic_keymap_cache_lru_layers[i] = layer;
+        dynamic_keymap_cache_load(dynamic_keymap_cache[dynamic_keymap_cache_lru_slots[i]], layer);
+    }
+    // Move the layer to the front
+    uint8_t slot = dynamic_keymap_cache_lru_slots[i];
+    for (; i > 0; i--) {
+        dynamic_keymap_cache_lru_layers[i] = dynamic_keymap_cache_lru_layers[i - 1];
+        dynamic_keymap_cache_lru_slots[i] = dynamic_keymap_cache_lru_slots[i - 1];
+    }
+    dynamic_keymap_cache_lru_layers[0] = layer;
+    dynamic_keymap_cache_lru_slots[0] = slot;
+    return dynamic_keymap_cache[slot];
+#    else
+    return dynamic_keymap_cache[layer];
+#    endif
+}
+#endif // DYNAMIC_KEYMAP_CACHE
+
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_CACHE
+    return dynamic_keymap_cache_get_layer(layer, true)[row * MATRIX_COLS + column];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
@@ -125,6 +198,20 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_CACHE
+    uint16_t *cache = dynamic_keymap_cache_get_layer(layer, false);
+    if (cache) {
+        cache[row * MATRIX_COLS + column] = keycode;
+    }
+#endif
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_clear();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    if (layer == 0) {
+        ghost_real_keys_clear();
+    }
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -134,11 +221,15 @@ void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+#    ifdef DYNAMIC_KEYMAP_CACHE
+    return dynamic_keymap_encoder_cache[layer][encoder_id][clockwise ? 0 : 1];
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
     keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
+#    endif
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
@@ -147,9 +238,37 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+#    ifdef DYNAMIC_KEYMAP_CACHE
+    dynamic_keymap_encoder_cache[layer][encoder_id][clockwise ? 0 : 1] = keycode;
+#    endif
 }
 #endif // ENCODER_MAP_ENABLE
 
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_CACHE
+#    if DYNAMIC_KEYMAP_CACHE_LAYERS < DYNAMIC_KEYMAP_LAYER_COUNT
+    for (uint8_t i = 0; i < DYNAMIC_KEYMAP_CACHE_LAYERS; i++) {
+        dynamic_keymap_cache_lru_layers[i] = DYNAMIC_KEYMAP_CACHE_SLOT_EMPTY;
+        dynamic_keymap_cache_lru_slots[i] = i;
+    }
+#    else
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        dynamic_keymap_cache_load(dynamic_keymap_cache[layer], layer);
+    }
+#    endif
+#    ifdef ENCODER_MAP_ENABLE
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t encoder = 0; encoder < NUM_ENCODERS; encoder++) {
+            uint8_t *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder);
+            for (uint8_t direction = 0; direction < NUM_DIRECTIONS; direction++) {
+                dynamic_keymap_encoder_cache[layer][encoder][direction] = ((uint16_t)eeprom_read_byte(address + direction * 2) << 8) | eeprom_read_byte(address + direction * 2 + 1);
+            }
+        }
+    }
+#    endif
+#endif // DYNAMIC_KEYMAP_CACHE
+}
+
 void dynamic_keymap_reset(void) {
     // Reset the keymaps in EEPROM to what is in flash.
     for (int layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
@@ -167,32 +286,48 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+// Returns how many bytes of a `size` byte access at `offset` fall within a `total` byte region
+static uint16_t dynamic_keymap_clamp_buffer(uint16_t offset, uint16_t size, uint16_t total) {
+    if (offset >= total) {
+        return 0;
+    }
+    return size < total - offset ? size : total - offset;
+}
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t length                     = dynamic_keymap_clamp_buffer(offset, size, dynamic_keymap_eeprom_size);
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), length);
+    memset(data + length, 0x00, size - length);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+    uint16_t length                     = dynamic_keymap_clamp_buffer(offset, size, dynamic_keymap_eeprom_size);
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), length);
+#ifdef DYNAMIC_KEYMAP_CACHE
+    for (uint16_t i = 0; i < length; i++) {
+        uint16_t  position = (offset + i) / 2;
+        uint16_t *cache    = dynamic_keymap_cache_get_layer(position / DYNAMIC_KEYMAP_LAYER_SIZE, false);
+        if (cache) {
+            uint16_t *keycode = &cache[position % DYNAMIC_KEYMAP_LAYER_SIZE];
+            // Big endian, high byte first
+            if ((offset + i) & 1) {
+                *keycode = (*keycode & 0xFF00) | data[i];
+            } else {
+                *keycode = (*keycode & 0x00FF) | ((uint16_t)data[i] << 8);
+            }
         }
-        source++;
-        target++;
     }
+#endif
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_clear();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    if (offset < MATRIX_ROWS * MATRIX_COLS * 2) {
+        ghost_real_keys_clear();
+    }
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,37 +355,21 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t length = dynamic_keymap_clamp_buffer(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_read_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
+    memset(data + length, 0x00, size - length);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t length = dynamic_keymap_clamp_buffer(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (p != end) {
-        eeprom_update_byte(p, 0);
-        ++p;
+    static const uint8_t zeroes[32] = {0};
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(zeroes)) {
+        uint16_t length = dynamic_keymap_clamp_buffer(offset, sizeof(zeroes), DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+        eeprom_update_block(zeroes, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), length);
     }
 }
 
@@ -32,6 +32,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "action_tapping.h"
+#include "action_util.h"
+#include "profiling.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -104,6 +107,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -131,6 +137,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LEADER_ENABLE
 #    include "leader.h"
 #endif
+#ifdef SEND_STRING_ENABLE
+#    include "send_string.h"
+#endif
 #ifdef UNICODE_COMMON_ENABLE
 #    include "unicode.h"
 #endif
@@ -140,6 +149,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -217,16 +229,33 @@ uint32_t get_matrix_scan_rate(void) {
 #endif
 
 #ifdef MATRIX_HAS_GHOST
-static matrix_row_t get_real_keys(uint8_t row, matrix_row_t rowdata) {
-    matrix_row_t out = 0;
-    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-        // read each key in the row data and check if the keymap defines it as a real key
-        if (keycode_at_keymap_location(0, row, col) && (rowdata & (((matrix_row_t)1) << col))) {
-            // this creates new row data, if a key is defined in the keymap, it will be set here
-            out |= ((matrix_row_t)1) << col;
+/** \brief Real key masks
+ *
+ * Per row, the columns that have a key on layer 0 of the keymap. Computed
+ * lazily, as the dynamic keymap is only available after matrix_init().
+ */
+static matrix_row_t real_keys[MATRIX_ROWS];
+static bool         real_keys_valid = false;
+
+/** \brief Ghost real keys clear
+ *
+ * Drops the real key masks, e.g. after the keymap has been changed at runtime.
+ */
+void ghost_real_keys_clear(void) {
+    real_keys_valid = false;
+}
+
+static void update_real_keys(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        real_keys[row] = 0;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            // check if the keymap defines each key as a real key
+            if (keycode_at_keymap_location(0, row, col)) {
+                real_keys[row] |= ((matrix_row_t)1) << col;
+            }
         }
     }
-    return out;
+    real_keys_valid = true;
 }
 
 static inline bool popcount_more_than_one(matrix_row_t rowdata) {
@@ -235,11 +264,15 @@ static inline bool popcount_more_than_one(matrix_row_t rowdata) {
 }
 
 static inline bool has_ghost_in_row(uint8_t row, matrix_row_t rowdata) {
+    if (!real_keys_valid) {
+        update_real_keys();
+    }
+
     /* No ghost exists when less than 2 keys are down on the row.
     If there are "active" blanks in the matrix, the key can't be pressed by the user,
     there is no doubt as to which keys are really being pressed.
     The ghosts will be ignored, they are KC_NO.   */
-    rowdata = get_real_keys(row, rowdata);
+    rowdata &= real_keys[row];
     if ((popcount_more_than_one(rowdata)) == 0) {
         return false;
     }
@@ -251,7 +284,7 @@ static inline bool has_ghost_in_row(uint8_t row, matrix_row_t rowdata) {
     we are checking one row at a time, not all of them at once.
     */
     for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
-        if (i != row && popcount_more_than_one(get_real_keys(i, matrix_get_row(i)) & rowdata)) {
+        if (i != row && popcount_more_than_one(matrix_get_row(i) & real_keys[i] & rowdata)) {
             return true;
         }
     }
@@ -375,6 +408,22 @@ void housekeeping_task(void) {
     housekeeping_task_user();
 }
 
+/** \brief keyboard_idle_kb
+ *
+ * Override this function to put the MCU to sleep until the given number of milliseconds has passed or
+ * an interrupt occurs. This is specific to keyboard-level functionality.
+ */
+__attribute__((weak)) void keyboard_idle_kb(uint32_t idle_time_ms) {
+    keyboard_idle_user(idle_time_ms);
+}
+
+/** \brief keyboard_idle_user
+ *
+ * Override this function to run code when the main loop has no timed work to do.
+ * This is specific to user/keymap-level functionality.
+ */
+__attribute__((weak)) void keyboard_idle_user(uint32_t idle_time_ms) {}
+
 /** \brief quantum_init
  *
  * Init global state
@@ -419,6 +468,9 @@ void keyboard_init(void) {
 #endif
     matrix_init();
     quantum_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
     led_init_ports();
 #ifdef BACKLIGHT_ENABLE
     backlight_init_ports();
@@ -456,6 +508,12 @@ void keyboard_init(void) {
 #ifdef STENO_ENABLE_ALL
     steno_init();
 #endif
+#ifdef COMBO_ENABLE
+    combo_init();
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    key_override_init();
+#endif
 #if defined(NKRO_ENABLE) && defined(FORCE_NKRO)
     keymap_config.nkro = 1;
     eeconfig_update_keymap(keymap_config.raw);
@@ -507,11 +565,45 @@ void switch_events(uint8_t row, uint8_t col, bool pressed) {
 #endif
 }
 
+static inline uint32_t idle_time_min(uint32_t idle_time, uint32_t task_idle_time) {
+    return task_idle_time < idle_time ? task_idle_time : idle_time;
+}
+
+/**
+ * @brief Number of milliseconds until a tick event can change the state of the
+ * tapping or one shot state machines.
+ */
+static uint32_t action_idle_time(void) {
+    uint32_t idle_time = IDLE_TIME_FOREVER;
+#if !defined(NO_ACTION_ONESHOT) && (defined(ONESHOT_TIMEOUT) && (ONESHOT_TIMEOUT > 0))
+    if (keymap_config.oneshot_enable) {
+        if (get_oneshot_mods() || is_oneshot_layer_active()) {
+            return 0;
+        }
+#    ifdef SWAP_HANDS_ENABLE
+        // the timeout is only cleared by a tick, before the next key would be swapped
+        idle_time = oneshot_swaphands_idle_time();
+#    endif
+    }
+#endif
+#ifndef NO_ACTION_TAPPING
+    idle_time = idle_time_min(idle_time, action_tapping_idle_time());
+#endif
+    return idle_time;
+}
+
 /**
  * @brief Generates a tick event at a maximum rate of 1KHz that drives the
  * internal QMK state machine.
  */
 static inline void generate_tick_event(void) {
+#ifdef KEYBOARD_IDLE_MODE
+    // Nothing in the action pipeline is waiting on the clock
+    if (action_idle_time() > 0) {
+        return;
+    }
+#endif
+
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
@@ -613,97 +705,186 @@ void quantum_task(void) {
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
+    PROFILE_TASK(MUSIC_TASK, music_task());
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    PROFILE_TASK(KEY_OVERRIDE_TASK, key_override_task());
 #endif
 
 #ifdef SEQUENCER_ENABLE
-    sequencer_task();
+    PROFILE_TASK(SEQUENCER_TASK, sequencer_task());
+#endif
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+    PROFILE_TASK(SEND_STRING_ASYNC_TASK, send_string_async_task());
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    PROFILE_TASK(TAP_DANCE_TASK, tap_dance_task());
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    PROFILE_TASK(COMBO_TASK, combo_task());
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    PROFILE_TASK(LEADER_TASK, leader_task());
 #endif
 
 #ifdef WPM_ENABLE
-    decay_wpm();
+    PROFILE_TASK(DECAY_WPM, decay_wpm());
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
-    dip_switch_task();
+    PROFILE_TASK(DIP_SWITCH_TASK, dip_switch_task());
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    PROFILE_TASK(AUTOSHIFT_MATRIX_SCAN, autoshift_matrix_scan());
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    PROFILE_TASK(CAPS_WORD_TASK, caps_word_task());
 #endif
 
 #ifdef SECURE_ENABLE
-    secure_task();
+    PROFILE_TASK(SECURE_TASK, secure_task());
+#endif
+}
+
+/** \brief Number of milliseconds until a task has timed work to do.
+ *
+ * Matrix and encoder changes are not taken into account, except that with
+ * MATRIX_WAKE_ON_CHANGE held or debouncing keys keep the keyboard busy.
+ * Features that do not report a deadline keep the keyboard busy while they are enabled.
+ *
+ * @return 0 if the main loop should keep running, IDLE_TIME_FOREVER if nothing is scheduled
+ */
+uint32_t keyboard_idle_time(void) {
+#if defined(SPLIT_KEYBOARD) || defined(QUANTUM_PAINTER_ENABLE) || defined(RGBLIGHT_ENABLE) || defined(BACKLIGHT_ENABLE) || defined(POINTING_DEVICE_ENABLE) || defined(ST7565_ENABLE) || defined(PS2_MOUSE_ENABLE) || defined(MIDI_ENABLE) || defined(JOYSTICK_ENABLE) || defined(BLUETOOTH_ENABLE) || defined(HAPTIC_ENABLE) || defined(OS_DETECTION_ENABLE) || defined(DIP_SWITCH_ENABLE)
+    // these poll or animate on every iteration
+    return 0;
+#else
+    uint32_t idle_time = action_idle_time();
+
+#    ifdef MATRIX_WAKE_ON_CHANGE
+    // keys are held or still debouncing
+    if (!matrix_is_waiting_for_change()) return 0;
+#    endif
+
+#    ifdef AUDIO_ENABLE
+    if (audio_is_playing_note() || audio_is_playing_melody()) return 0;
+#    endif
+#    ifdef SEQUENCER_ENABLE
+    if (is_sequencer_on()) return 0;
+#    endif
+#    ifdef WPM_ENABLE
+    if (get_current_wpm() > 0) return 0;
+#    endif
+#    ifdef CAPS_WORD_ENABLE
+    if (is_caps_word_on()) return 0;
+#    endif
+#    ifdef SECURE_ENABLE
+    if (!secure_is_locked()) return 0;
+#    endif
+#    ifdef MOUSEKEY_ENABLE
+    report_mouse_t mouse_report = mousekey_get_report();
+    if (mouse_report.x || mouse_report.y || mouse_report.v || mouse_report.h) return 0;
+#    endif
+#    if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC)
+    if (send_string_async_is_busy()) return 0;
+#    endif
+
+#    ifdef KEY_OVERRIDE_ENABLE
+    idle_time = idle_time_min(idle_time, key_override_idle_time());
+#    endif
+#    ifdef TAP_DANCE_ENABLE
+    idle_time = idle_time_min(idle_time, tap_dance_idle_time());
+#    endif
+#    ifdef COMBO_ENABLE
+    idle_time = idle_time_min(idle_time, combo_idle_time());
+#    endif
+#    ifdef LEADER_ENABLE
+    idle_time = idle_time_min(idle_time, leader_idle_time());
+#    endif
+#    ifdef AUTO_SHIFT_ENABLE
+    idle_time = idle_time_min(idle_time, autoshift_idle_time());
+#    endif
+#    ifdef DEFERRED_EXEC_ENABLE
+    uint32_t trigger_time;
+    if (deferred_exec_next_deadline(&trigger_time)) {
+        uint32_t now = timer_read32();
+        idle_time    = idle_time_min(idle_time, timer_expired32(now, trigger_time) ? 0 : TIMER_DIFF_32(trigger_time, now));
+    }
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    idle_time = idle_time_min(idle_time, led_matrix_idle_time());
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    idle_time = idle_time_min(idle_time, rgb_matrix_idle_time());
+#    endif
+#    ifdef OLED_ENABLE
+    idle_time = idle_time_min(idle_time, oled_idle_time());
+#    endif
+
+    return idle_time;
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool matrix_changed;
+    PROFILE_TASK(MATRIX_TASK, matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    PROFILE_TASK(QUANTUM_TASK, quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+    PROFILE_TASK(SPLIT_WATCHDOG_TASK, split_watchdog_task());
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    PROFILE_TASK(RGBLIGHT_TASK, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    PROFILE_TASK(LED_MATRIX_TASK, led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    PROFILE_TASK(RGB_MATRIX_TASK, rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
+    PROFILE_TASK(BACKLIGHT_TASK, backlight_task());
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_task()) {
+    bool encoder_changed;
+    PROFILE_TASK(ENCODER_TASK, encoder_changed = encoder_task());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    PROFILE_TASK(POINTING_DEVICE_TASK, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    PROFILE_TASK(OLED_TASK, oled_task());
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -711,7 +892,7 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    PROFILE_TASK(ST7565_TASK, st7565_task());
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -720,32 +901,32 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    PROFILE_TASK(MOUSEKEY_TASK, mousekey_task());
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
+    PROFILE_TASK(PS2_MOUSE_TASK, ps2_mouse_task());
 #endif
 
 #ifdef MIDI_ENABLE
-    midi_task();
+    PROFILE_TASK(MIDI_TASK, midi_task());
 #endif
 
 #ifdef JOYSTICK_ENABLE
-    joystick_task();
+    PROFILE_TASK(JOYSTICK_TASK, joystick_task());
 #endif
 
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    PROFILE_TASK(BLUETOOTH_TASK, bluetooth_task());
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    PROFILE_TASK(HAPTIC_TASK, haptic_task());
 #endif
 
-    led_task();
+    PROFILE_TASK(LED_TASK, led_task());
 
 #ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+    PROFILE_TASK(OS_DETECTION_TASK, os_detection_task());
 #endif
 }
@@ -123,6 +123,13 @@ void housekeeping_task(void);      // To be executed by the main loop in each ba
 void housekeeping_task_kb(void);   // To be overridden by keyboard-level code
 void housekeeping_task_user(void); // To be overridden by user/keymap-level code
 
+/* returned by the idle time functions when nothing is scheduled */
+#define IDLE_TIME_FOREVER UINT32_MAX
+
+uint32_t keyboard_idle_time(void);                  // Number of milliseconds until a task has timed work to do, not counting matrix or encoder changes
+void     keyboard_idle_kb(uint32_t idle_time_ms);   // Called by the main loop when idle, to be overridden by keyboard-level code
+void     keyboard_idle_user(uint32_t idle_time_ms); // Called by the main loop when idle, to be overridden by user/keymap-level code
+
 uint32_t last_input_activity_time(void);    // Timestamp of the last matrix or encoder or pointing device activity
 uint32_t last_input_activity_elapsed(void); // Number of milliseconds since the last matrix or encoder or pointing device activity
 
@@ -139,6 +146,10 @@ void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timesta
 
 uint32_t get_matrix_scan_rate(void);
 
+#ifdef MATRIX_HAS_GHOST
+void ghost_real_keys_clear(void); // Drop the real key masks used for ghost detection, required after changing layer 0 of the keymap
+#endif
+
 #ifdef __cplusplus
 }
 #endif
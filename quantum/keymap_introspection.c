@@ -94,6 +94,10 @@ uint16_t keycode_at_dip_switch_map_location(uint8_t switch_idx, bool on) {
 
 #if defined(COMBO_ENABLE)
 
+#    ifdef COMBO_KEYCODE_INDEX
+_Static_assert(sizeof(key_combos) / sizeof(combo_t) * 2 <= COMBO_INDEX_LENGTH, "COMBO_INDEX_LENGTH too small for key_combos, which needs at least two entries per combo");
+#    endif // COMBO_KEYCODE_INDEX
+
 uint16_t combo_count_raw(void) {
     return sizeof(key_combos) / sizeof(combo_t);
 }
@@ -0,0 +1,181 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_tracker.h"
+#include "timer.h"
+#include "profiling.h"
+#include "print.h"
+
+static latency_stats_t stats;
+
+// Detection timestamp of the oldest event processed since the last report
+static bool     pending = false;
+static uint32_t pending_start;
+// process_record() nests when buffered records are replayed
+static uint8_t depth = 0;
+
+static uint32_t ticks_per_ms(void) {
+    return profiling_timestamp_frequency() / 1000;
+}
+
+// Histogram buckets are LATENCY_TRACKER_BUCKET_WIDTH milliseconds wide
+static uint32_t bucket_width(void) {
+    uint32_t width = LATENCY_TRACKER_BUCKET_WIDTH * ticks_per_ms();
+    return width ? width : 1;
+}
+
+void latency_tracker_event_begin(keyevent_t event) {
+    // Events only carry a millisecond time, so the time spent in buffers is added at that resolution
+    uint32_t start = profiling_timestamp() - (uint32_t)TIMER_DIFF_16(timer_read(), event.time) * ticks_per_ms();
+
+    // Keep the older time, replayed records were detected before the current one
+    if (!pending || (int32_t)(pending_start - start) > 0) {
+        pending_start = start;
+    }
+    pending = true;
+    depth++;
+}
+
+void latency_tracker_event_end(void) {
+    if (depth > 0 && --depth == 0) {
+        pending = false;
+    }
+}
+
+void latency_tracker_report_sent(void) {
+    if (!pending) {
+        return;
+    }
+
+    pending = false;
+    latency_tracker_record(profiling_timestamp() - pending_start);
+}
+
+void latency_tracker_record(uint32_t latency) {
+    if (stats.count == 0 || latency < stats.min) {
+        stats.min = latency;
+    }
+    if (latency > stats.max) {
+        stats.max = latency;
+    }
+    if (stats.count < UINT32_MAX) {
+        stats.count++;
+    }
+    stats.sum += latency;
+
+    uint32_t index = latency / bucket_width();
+    if (index >= LATENCY_TRACKER_BUCKETS) {
+        index = LATENCY_TRACKER_BUCKETS - 1;
+    }
+    if (stats.histogram[index] < UINT16_MAX) {
+        stats.histogram[index]++;
+    }
+}
+
+void latency_tracker_reset(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+const latency_stats_t *latency_tracker_get_stats(void) {
+    return &stats;
+}
+
+uint32_t latency_tracker_average(void) {
+    return stats.count ? stats.sum / stats.count : 0;
+}
+
+uint32_t latency_tracker_percentile(uint8_t percent) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < LATENCY_TRACKER_BUCKETS; i++) {
+        total += stats.histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Smallest bucket covering at least percent% of the histogram
+    uint32_t target = (total * (percent > 100 ? 100 : percent) + 99) / 100;
+    uint32_t seen   = 0;
+    for (uint8_t i = 0; i < LATENCY_TRACKER_BUCKETS - 1; i++) {
+        seen += stats.histogram[i];
+        if (seen >= target) {
+            uint32_t upper_bound = (i + 1) * bucket_width() - 1;
+            return upper_bound < stats.max ? upper_bound : stats.max;
+        }
+    }
+    return stats.max;
+}
+
+void latency_tracker_print(void) {
+    uprintf("latency: %lu ticks/s\n", (unsigned long)profiling_timestamp_frequency());
+    uprintf("latency: n=%lu min=%lu avg=%lu max=%lu p50=%lu p99=%lu\n", (unsigned long)stats.count, (unsigned long)stats.min, (unsigned long)latency_tracker_average(), (unsigned long)stats.max, (unsigned long)latency_tracker_percentile(50), (unsigned long)latency_tracker_percentile(99));
+}
+
+static void write_u16(uint8_t *data, uint16_t value) {
+    data[0] = value >> 8;
+    data[1] = value & 0xFF;
+}
+
+static void write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+bool latency_tracker_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, latency_tracker_command, ... ]
+    if (length < 32 || data[0] != LATENCY_TRACKER_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_id   = &data[0];
+    uint8_t *command_data = &data[2];
+
+    switch (data[1]) {
+        case id_latency_tracker_get_info: {
+            // [ bucket_count(2), bucket_width(2) ]
+            write_u16(&command_data[0], LATENCY_TRACKER_BUCKETS);
+            write_u16(&command_data[2], LATENCY_TRACKER_BUCKET_WIDTH);
+            break;
+        }
+        case id_latency_tracker_get_stats: {
+            // [ count(4), min(4), avg(4), max(4), p50(4), p99(4), frequency(4) ]
+            write_u32(&command_data[0], stats.count);
+            write_u32(&command_data[4], stats.min);
+            write_u32(&command_data[8], latency_tracker_average());
+            write_u32(&command_data[12], stats.max);
+            write_u32(&command_data[16], latency_tracker_percentile(50));
+            write_u32(&command_data[20], latency_tracker_percentile(99));
+            write_u32(&command_data[24], profiling_timestamp_frequency());
+            break;
+        }
+        case id_latency_tracker_get_histogram: {
+            // [ first_bucket(2), bucket_count, counts(2)... ]
+            uint16_t first = (command_data[0] << 8) | command_data[1];
+            if (first >= LATENCY_TRACKER_BUCKETS) {
+                *command_id = 0xFF;
+                break;
+            }
+            uint16_t count = (length - 5) / 2;
+            if (count > LATENCY_TRACKER_BUCKETS - first) {
+                count = LATENCY_TRACKER_BUCKETS - first;
+            }
+            command_data[2] = count;
+            for (uint8_t i = 0; i < count; i++) {
+                write_u16(&command_data[3 + 2 * i], stats.histogram[first + i]);
+            }
+            break;
+        }
+        case id_latency_tracker_reset_stats: {
+            latency_tracker_reset();
+            break;
+        }
+        default: {
+            *command_id = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,125 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+/**
+ * \file
+ *
+ * \defgroup latency_tracker Latency Tracker
+ *
+ * Measures the time from a key event being detected by the matrix scan until
+ * the first keyboard report caused by it is handed to the host driver, using
+ * the profiling timestamp. Events held back by the tapping or combo buffers
+ * are measured from their original detection time, so the delay they add is
+ * part of the result. That delay is only known to the millisecond.
+ * \{
+ */
+
+#ifndef LATENCY_TRACKER_BUCKETS
+#    define LATENCY_TRACKER_BUCKETS 32
+#endif
+
+#ifndef LATENCY_TRACKER_BUCKET_WIDTH
+#    define LATENCY_TRACKER_BUCKET_WIDTH 1
+#endif
+
+#if LATENCY_TRACKER_BUCKETS < 2
+#    error "LATENCY_TRACKER_BUCKETS must be at least 2"
+#endif
+
+#ifndef LATENCY_TRACKER_RAW_HID_COMMAND_ID
+#    define LATENCY_TRACKER_RAW_HID_COMMAND_ID 0xFC
+#endif
+
+/**
+ * \brief Latency statistics, all durations in timestamp ticks.
+ *
+ * Bucket `n` counts latencies of at least `n * LATENCY_TRACKER_BUCKET_WIDTH`
+ * milliseconds, and shorter than `n + 1` times that. The last bucket also
+ * holds everything longer.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t histogram[LATENCY_TRACKER_BUCKETS];
+} latency_stats_t;
+
+enum latency_tracker_raw_hid_command {
+    id_latency_tracker_get_info      = 0x00,
+    id_latency_tracker_get_stats     = 0x01,
+    id_latency_tracker_get_histogram = 0x02,
+    id_latency_tracker_reset_stats   = 0x03,
+};
+
+/**
+ * \brief Start tracking an event, called before it is processed.
+ */
+void latency_tracker_event_begin(keyevent_t event);
+
+/**
+ * \brief Stop tracking the current event, called once it has been processed.
+ *
+ * Events that did not cause a report are discarded.
+ */
+void latency_tracker_event_end(void);
+
+/**
+ * \brief Record the latency of the tracked event, called when a report is sent.
+ */
+void latency_tracker_report_sent(void);
+
+/**
+ * \brief Add a latency sample to the statistics.
+ *
+ * \param latency The latency in timestamp ticks.
+ */
+void latency_tracker_record(uint32_t latency);
+
+/**
+ * \brief Clear the statistics.
+ */
+void latency_tracker_reset(void);
+
+/**
+ * \brief Retrieve the statistics.
+ */
+const latency_stats_t *latency_tracker_get_stats(void);
+
+/**
+ * \brief Average latency in timestamp ticks.
+ */
+uint32_t latency_tracker_average(void);
+
+/**
+ * \brief Estimate a percentile from the histogram.
+ *
+ * The result is the upper bound of the bucket the percentile falls into,
+ * clamped to the longest recorded latency.
+ *
+ * \param percent The percentile, e.g. 99.
+ */
+uint32_t latency_tracker_percentile(uint8_t percent);
+
+/**
+ * \brief Print the statistics over the console.
+ */
+void latency_tracker_print(void);
+
+/**
+ * \brief Handle a latency tracker raw HID request.
+ *
+ * Requests start with `LATENCY_TRACKER_RAW_HID_COMMAND_ID`, followed by one of
+ * `latency_tracker_raw_hid_command`. The response is written back into `data`.
+ *
+ * \return `true` if the request was handled and `data` should be sent back to the host.
+ */
+bool latency_tracker_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/** \} */
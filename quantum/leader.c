@@ -2,25 +2,46 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "leader.h"
+#include "keyboard.h"
 #include "timer.h"
 #include "util.h"
 
 #include <string.h>
 
+#if __has_include("leader_data.h")
+#    include "progmem.h"
+#    include "quantum.h"
+#    include "leader_data.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
 
 // Leader key stuff
-bool     leading              = false;
-uint16_t leader_time          = 0;
-uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
-uint8_t  leader_sequence_size = 0;
+bool     leading                                     = false;
+uint16_t leader_time                                 = 0;
+uint16_t leader_sequence[LEADER_SEQUENCE_MAX_LENGTH] = {0};
+uint8_t  leader_sequence_size                        = 0;
+
+#ifdef LEADER_TRIE_SIZE
+// Node header flag marking a node that completes a sequence, see `qmk generate-leader-data`
+#    define LEADER_TRIE_HAS_KEYCODE 0x8000
+#    define LEADER_TRIE_CHILD_COUNT(header) ((header) & ~LEADER_TRIE_HAS_KEYCODE)
+
+// Offset of the trie node reached by the keys so far, only valid while leader_trie_matching is set
+static uint16_t leader_trie_node     = 0;
+static bool     leader_trie_matching = false;
+#endif
 
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+__attribute__((weak)) bool leader_sequence_matched_user(uint16_t keycode) {
+    return true;
+}
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -30,10 +51,25 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_TRIE_SIZE
+    leader_trie_node     = 0;
+    leader_trie_matching = true;
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_TRIE_SIZE
+    if (leader_trie_matching && leader_sequence_size > 0) {
+        leader_trie_matching = false;
+        if (pgm_read_word(&leader_trie[leader_trie_node]) & LEADER_TRIE_HAS_KEYCODE) {
+            uint16_t keycode = pgm_read_word(&leader_trie[leader_trie_node + 1]);
+            if (leader_sequence_matched_user(keycode)) {
+                tap_code16(keycode);
+            }
+        }
+    }
+#endif
     leader_end_user();
 }
 
@@ -43,12 +79,56 @@ void leader_task(void) {
     }
 }
 
+uint32_t leader_idle_time(void) {
+    if (!leading) {
+        return IDLE_TIME_FOREVER;
+    }
+#if defined(LEADER_NO_TIMEOUT)
+    if (leader_sequence_size == 0) {
+        return IDLE_TIME_FOREVER;
+    }
+#endif
+
+    uint16_t elapsed = timer_elapsed(leader_time);
+    return elapsed > LEADER_TIMEOUT ? 0 : LEADER_TIMEOUT + 1 - elapsed;
+}
+
 bool leader_sequence_active(void) {
     return leading;
 }
 
+#ifdef LEADER_TRIE_SIZE
+/**
+ * Follow the trie from the current node along the given keycode.
+ *
+ * \return `true` if the sequence so far is complete and no longer sequence starts with it.
+ */
+static bool leader_trie_step(uint16_t keycode) {
+    if (!leader_trie_matching) {
+        return false;
+    }
+
+    uint16_t header = pgm_read_word(&leader_trie[leader_trie_node]);
+    uint16_t link   = leader_trie_node + 1 + ((header & LEADER_TRIE_HAS_KEYCODE) ? 1 : 0);
+    for (uint16_t i = 0; i < LEADER_TRIE_CHILD_COUNT(header); i++, link += 2) {
+        if (pgm_read_word(&leader_trie[link]) == keycode) {
+            leader_trie_node = pgm_read_word(&leader_trie[link + 1]);
+            header           = pgm_read_word(&leader_trie[leader_trie_node]);
+            return (header & LEADER_TRIE_HAS_KEYCODE) && LEADER_TRIE_CHILD_COUNT(header) == 0;
+        }
+    }
+
+    // No sequence starts with the keys so far
+    leader_trie_matching = false;
+    return false;
+}
+#endif
+
 bool leader_sequence_add(uint16_t keycode) {
     if (leader_sequence_size >= ARRAY_SIZE(leader_sequence)) {
+#ifdef LEADER_TRIE_SIZE
+        leader_trie_matching = false;
+#endif
         return false;
     }
 
@@ -61,6 +141,13 @@ bool leader_sequence_add(uint16_t keycode) {
     leader_sequence[leader_sequence_size] = keycode;
     leader_sequence_size++;
 
+#ifdef LEADER_TRIE_SIZE
+    // Nothing else can match, so there is no need to wait for the timeout
+    if (leader_trie_step(keycode)) {
+        leader_end();
+    }
+#endif
+
     return true;
 }
 
@@ -4,6 +4,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+// Number of keys the sequence buffer holds, also read by `qmk generate-leader-data`
+#define LEADER_SEQUENCE_MAX_LENGTH 5
+
 /**
  * \file
  *
@@ -21,6 +24,15 @@ void leader_start_user(void);
  */
 void leader_end_user(void);
 
+/**
+ * \brief User callback, invoked when a sequence from `leader_data.h` matches.
+ *
+ * \param keycode The keycode assigned to the sequence.
+ *
+ * \return `true` to tap the keycode, `false` if it was handled by the callback.
+ */
+bool leader_sequence_matched_user(uint16_t keycode);
+
 /**
  * Begin the leader sequence, resetting the buffer and timer.
  */
@@ -33,6 +45,13 @@ void leader_end(void);
 
 void leader_task(void);
 
+/**
+ * Number of milliseconds until the leader sequence times out.
+ *
+ * \return `IDLE_TIME_FOREVER` if no sequence is waiting on the timer.
+ */
+uint32_t leader_idle_time(void);
+
 /**
  * Whether the leader sequence is active.
  */
@@ -43,6 +62,10 @@ bool leader_sequence_active(void);
  *
  * If `LEADER_NO_TIMEOUT` is defined, the timer is reset if the buffer is empty.
  *
+ * If the sequences from `leader_data.h` are used and the buffer now holds one
+ * of them which is not the start of a longer one, the leader sequence ends
+ * immediately instead of waiting for the timeout.
+ *
  * \param keycode The keycode to add.
  *
  * \return `true` if the keycode was added, `false` if the buffer is full.
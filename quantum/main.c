@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "profiling.h"
 
 void platform_setup(void);
 
@@ -57,20 +58,28 @@ int main(void) {
 
     /* Main loop */
     while (true) {
-        protocol_task();
+        PROFILE_TASK(PROTOCOL_TASK, protocol_task());
 
 #ifdef QUANTUM_PAINTER_ENABLE
         // Run Quantum Painter task
         void qp_internal_task(void);
-        qp_internal_task();
+        PROFILE_TASK(QP_INTERNAL_TASK, qp_internal_task());
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
         // Run deferred executions
         void deferred_exec_task(void);
-        deferred_exec_task();
+        PROFILE_TASK(DEFERRED_EXEC_TASK, deferred_exec_task());
 #endif // DEFERRED_EXEC_ENABLE
 
-        housekeeping_task();
+        PROFILE_TASK(HOUSEKEEPING_TASK, housekeeping_task());
+
+#ifdef KEYBOARD_IDLE_MODE
+        // Let the platform sleep until a task has timed work to do
+        uint32_t idle_time = keyboard_idle_time();
+        if (idle_time > 0) {
+            keyboard_idle_kb(idle_time);
+        }
+#endif
     }
 }
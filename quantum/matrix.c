@@ -104,6 +104,71 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#if defined(MATRIX_PORT_SCAN) || defined(MATRIX_WAKE_ON_CHANGE)
+#    if defined(DIRECT_PINS) || !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS)
+#        error "MATRIX_PORT_SCAN and MATRIX_WAKE_ON_CHANGE require MATRIX_ROW_PINS and MATRIX_COL_PINS"
+#    endif
+
+// The pins read while an output is selected
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define MATRIX_INPUT_PINS col_pins
+#        define MATRIX_INPUT_COUNT MATRIX_COLS
+#    else
+#        define MATRIX_INPUT_PINS row_pins
+#        define MATRIX_INPUT_COUNT ROWS_PER_HAND
+#    endif
+#endif
+
+#ifdef MATRIX_PORT_SCAN
+#    ifndef gpio_read_port
+#        error "MATRIX_PORT_SCAN is not supported on this platform"
+#    endif
+
+// Inputs are read one port at a time, the pins are then picked out of the port values with precomputed masks
+#    define MATRIX_PORT_NONE 0xFF
+
+static pin_t            input_ports[MATRIX_INPUT_COUNT]; // one pin of each port
+static uint8_t          input_port_count;
+static uint8_t          input_port_index[MATRIX_INPUT_COUNT];
+static gpio_port_data_t input_pin_mask[MATRIX_INPUT_COUNT];
+
+static void matrix_init_input_ports(void) {
+    input_port_count = 0;
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        pin_t pin = MATRIX_INPUT_PINS[i];
+        if (pin == NO_PIN) {
+            input_port_index[i] = MATRIX_PORT_NONE;
+            continue;
+        }
+
+        uint8_t port = 0;
+        while (port < input_port_count && !gpio_same_port(input_ports[port], pin)) {
+            port++;
+        }
+        if (port == input_port_count) {
+            input_ports[input_port_count++] = pin;
+        }
+        input_port_index[i] = port;
+        input_pin_mask[i]   = gpio_pin_mask(pin);
+    }
+}
+
+static inline void readMatrixPorts(gpio_port_data_t port_values[]) {
+    for (uint8_t port = 0; port < input_port_count; port++) {
+        port_values[port] = gpio_read_port(input_ports[port]);
+    }
+}
+
+static inline uint8_t readMatrixPortPin(const gpio_port_data_t port_values[], uint8_t input) {
+    uint8_t port = input_port_index[input];
+    if (port != MATRIX_PORT_NONE) {
+        return (((port_values[port] & input_pin_mask[input]) != 0) == MATRIX_INPUT_PRESSED_STATE) ? 0 : 1;
+    } else {
+        return 1;
+    }
+}
+#endif
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -163,6 +228,18 @@ static void unselect_rows(void) {
     }
 }
 
+#            ifdef MATRIX_WAKE_ON_CHANGE
+static void select_outputs(void) {
+    for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
+        select_row(x);
+    }
+}
+
+static void unselect_outputs(void) {
+    unselect_rows();
+}
+#            endif
+
 __attribute__((weak)) void matrix_init_pins(void) {
     unselect_rows();
     for (uint8_t x = 0; x < MATRIX_COLS; x++) {
@@ -181,10 +258,19 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_PORT_SCAN
+    gpio_port_data_t port_values[MATRIX_INPUT_COUNT];
+    readMatrixPorts(port_values);
+#            endif
+
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
+#            ifdef MATRIX_PORT_SCAN
+        uint8_t pin_state = readMatrixPortPin(port_values, col_index);
+#            else
         uint8_t pin_state = readMatrixPin(col_pins[col_index]);
+#            endif
 
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
@@ -226,6 +312,18 @@ static void unselect_cols(void) {
     }
 }
 
+#            ifdef MATRIX_WAKE_ON_CHANGE
+static void select_outputs(void) {
+    for (uint8_t x = 0; x < MATRIX_COLS; x++) {
+        select_col(x);
+    }
+}
+
+static void unselect_outputs(void) {
+    unselect_cols();
+}
+#            endif
+
 __attribute__((weak)) void matrix_init_pins(void) {
     unselect_cols();
     for (uint8_t x = 0; x < ROWS_PER_HAND; x++) {
@@ -244,10 +342,19 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_PORT_SCAN
+    gpio_port_data_t port_values[MATRIX_INPUT_COUNT];
+    readMatrixPorts(port_values);
+#            endif
+
     // For each row...
     for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
         // Check row pin state
+#            ifdef MATRIX_PORT_SCAN
+        if (readMatrixPortPin(port_values, row_index) == 0) {
+#            else
         if (readMatrixPin(row_pins[row_index]) == 0) {
+#            endif
             // Pin LO, set col bit
             current_matrix[row_index] |= row_shifter;
             key_pressed = true;
@@ -270,6 +377,84 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_WAKE_ON_CHANGE
+/*
+ * Once no key is down and debouncing has settled, every output is left selected and the inputs
+ * are armed as pin change interrupts. A single read of the inputs then shows whether any key
+ * has been pressed, and the full scan only resumes once one has.
+ */
+static bool waiting_for_change = false;
+static bool wake_on_change     = false; // false if the inputs can't all be armed as interrupts
+
+bool matrix_is_waiting_for_change(void) {
+    return waiting_for_change;
+}
+
+static bool matrix_any_input_active(void) {
+#    ifdef MATRIX_PORT_SCAN
+    gpio_port_data_t port_values[MATRIX_INPUT_COUNT];
+    readMatrixPorts(port_values);
+#    endif
+
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+#    ifdef MATRIX_PORT_SCAN
+        if (readMatrixPortPin(port_values, i) == 0) {
+#    else
+        if (readMatrixPin(MATRIX_INPUT_PINS[i]) == 0) {
+#    endif
+            return true;
+        }
+    }
+    return false;
+}
+
+// Two inputs on the same interrupt line, e.g. the same pad number on STM32 EXTI, would take the line from each other
+static bool matrix_inputs_share_interrupt_line(void) {
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        if (MATRIX_INPUT_PINS[i] == NO_PIN) {
+            continue;
+        }
+        for (uint8_t j = i + 1; j < MATRIX_INPUT_COUNT; j++) {
+            if (MATRIX_INPUT_PINS[j] != NO_PIN && gpio_pin_interrupt_line(MATRIX_INPUT_PINS[i]) == gpio_pin_interrupt_line(MATRIX_INPUT_PINS[j])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void matrix_start_waiting_for_change(void) {
+    select_outputs();
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        if (MATRIX_INPUT_PINS[i] != NO_PIN) {
+            gpio_enable_pin_interrupt(MATRIX_INPUT_PINS[i]);
+        }
+    }
+    matrix_output_select_delay();
+    waiting_for_change = true;
+}
+
+static void matrix_stop_waiting_for_change(void) {
+    for (uint8_t i = 0; i < MATRIX_INPUT_COUNT; i++) {
+        if (MATRIX_INPUT_PINS[i] != NO_PIN) {
+            gpio_disable_pin_interrupt(MATRIX_INPUT_PINS[i]);
+        }
+    }
+    unselect_outputs();
+    matrix_output_unselect_delay(0, true); // wait for all inputs to go HIGH
+    waiting_for_change = false;
+}
+
+static bool matrix_is_empty(const matrix_row_t rows[]) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (rows[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -300,6 +485,19 @@ void matrix_init(void) {
     thatHand = ROWS_PER_HAND - thisHand;
 #endif
 
+#ifdef MATRIX_PORT_SCAN
+    // group the input pins by port, after the right hand pins are known
+    matrix_init_input_ports();
+#endif
+
+#ifdef MATRIX_WAKE_ON_CHANGE
+    if (waiting_for_change) {
+        matrix_stop_waiting_for_change();
+    }
+    // fall back to scanning, after the right hand pins are known
+    wake_on_change = !matrix_inputs_share_interrupt_line();
+#endif
+
     // initialize key pins
     matrix_init_pins();
 
@@ -320,9 +518,7 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -335,6 +531,22 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
     }
 #endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_WAKE_ON_CHANGE
+    // While waiting, the matrix is known to be empty until an input goes active
+    if (waiting_for_change && matrix_any_input_active()) {
+        matrix_stop_waiting_for_change();
+    }
+    if (!waiting_for_change) {
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -345,5 +557,15 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
+#ifdef MATRIX_WAKE_ON_CHANGE
+#    ifdef SPLIT_KEYBOARD
+    if (wake_on_change && !waiting_for_change && matrix_is_empty(raw_matrix) && matrix_is_empty(matrix + thisHand)) {
+#    else
+    if (wake_on_change && !waiting_for_change && matrix_is_empty(raw_matrix) && matrix_is_empty(matrix)) {
+#    endif
+        matrix_start_waiting_for_change();
+    }
+#endif
     return (uint8_t)changed;
 }
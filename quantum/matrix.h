@@ -65,6 +65,9 @@ void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
 
+/* whether the matrix is idle and only watching its inputs for a change (MATRIX_WAKE_ON_CHANGE) */
+bool matrix_is_waiting_for_change(void);
+
 /* power control */
 void matrix_power_up(void);
 void matrix_power_down(void);
@@ -321,6 +321,21 @@ void autoshift_matrix_scan(void) {
     }
 }
 
+uint32_t autoshift_idle_time(void) {
+    if (!autoshift_flags.in_progress) {
+        return IDLE_TIME_FOREVER;
+    }
+
+    const uint16_t timeout =
+#ifdef AUTO_SHIFT_TIMEOUT_PER_KEY
+        get_autoshift_timeout(autoshift_lastkey, &autoshift_lastrecord);
+#else
+        autoshift_timeout;
+#endif
+    const uint16_t elapsed = timer_elapsed(autoshift_time);
+    return elapsed >= timeout ? 0 : timeout - elapsed;
+}
+
 void autoshift_toggle(void) {
     autoshift_flags.enabled = !autoshift_flags.enabled;
     autoshift_flush_shift();
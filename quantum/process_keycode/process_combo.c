@@ -26,6 +26,7 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -94,6 +95,22 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEYCODE_INDEX
+/* Maps each keycode used by a combo to the combos containing it. Entries are
+ * sorted by keycode and, within a keycode, by combo index, so candidates are
+ * processed in the same order as a linear walk over all combos would. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+static combo_index_entry_t combo_index[COMBO_INDEX_LENGTH];
+static uint16_t            combo_index_size  = 0;
+static bool                combo_index_valid = false;
+/* Set whenever a combo may have left its reset state, so clear_combos() can
+ * skip walking every combo while only non-combo keys are being typed. */
+static bool combo_state_dirty = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -194,6 +211,12 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEYCODE_INDEX
+    if (combo_index_valid && !combo_state_dirty) {
+        return;
+    }
+    combo_state_dirty = false;
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -424,6 +447,10 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
         return false;
     }
 
+#ifdef COMBO_KEYCODE_INDEX
+    combo_state_dirty = true;
+#endif
+
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -534,6 +561,61 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+#ifdef COMBO_KEYCODE_INDEX
+bool combo_rebuild_index(void) {
+    combo_index_size  = 0;
+    combo_index_valid = false;
+
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        combo_t *combo = combo_get(idx);
+        uint16_t key;
+        for (uint8_t key_i = 0; (key = pgm_read_word(&combo->keys[key_i])) != COMBO_END; ++key_i) {
+            if (combo_index_size >= COMBO_INDEX_LENGTH) {
+                // Printed regardless of debug_enable, as combos keep working but silently get slower
+                xprintf("combo: COMBO_INDEX_LENGTH (%u) too small, falling back to checking every combo\n", COMBO_INDEX_LENGTH);
+                return false;
+            }
+            /* Insertion sort by keycode; combos are visited in ascending order,
+             * so inserting after equal keycodes keeps each run ordered by index. */
+            uint16_t pos = combo_index_size++;
+            while (pos > 0 && combo_index[pos - 1].keycode > key) {
+                combo_index[pos] = combo_index[pos - 1];
+                --pos;
+            }
+            combo_index[pos] = (combo_index_entry_t){
+                .keycode     = key,
+                .combo_index = idx,
+            };
+        }
+    }
+
+    combo_index_valid = true;
+    combo_state_dirty = true;
+    return true;
+}
+
+/* Returns the position of the first index entry for keycode, or the position
+ * it would be inserted at if no combo contains it. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t lo = 0, hi = combo_index_size;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
+void combo_init(void) {
+#ifdef COMBO_KEYCODE_INDEX
+    combo_rebuild_index();
+#endif
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -564,10 +646,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEYCODE_INDEX
+    if (combo_index_valid) {
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_size && combo_index[i].keycode == keycode; ++i) {
+            uint16_t idx   = combo_index[i].combo_index;
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -625,6 +718,16 @@ void combo_task(void) {
 #endif
 }
 
+uint32_t combo_idle_time(void) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        return elapsed > longest_term ? 0 : longest_term + 1 - elapsed;
+    }
+#endif
+    return IDLE_TIME_FOREVER;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
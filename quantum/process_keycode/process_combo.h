@@ -38,6 +38,9 @@
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
+#ifndef COMBO_INDEX_LENGTH
+#    define COMBO_INDEX_LENGTH 384
+#endif
 
 typedef struct combo_t {
     const uint16_t *keys;
@@ -73,11 +76,20 @@ typedef struct combo_t {
 /* check if keycode is only modifiers */
 #define KEYCODE_IS_MOD(code) (IS_MODIFIER_KEYCODE(code) || (IS_QK_MODS(code) && !QK_MODS_GET_BASIC_KEYCODE(code)))
 
+void combo_init(void);
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+uint32_t combo_idle_time(void);
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_KEYCODE_INDEX
+/* Returns false if the combos need more than COMBO_INDEX_LENGTH entries, in
+ * which case every key event is checked against every combo. */
+bool combo_rebuild_index(void);
+#endif
@@ -28,6 +28,14 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
+#ifndef KEY_OVERRIDE_INDEX_LENGTH
+#    define KEY_OVERRIDE_INDEX_LENGTH 64
+#endif
+
+#if KEY_OVERRIDE_INDEX_LENGTH > 255
+#    error "KEY_OVERRIDE_INDEX_LENGTH must not be larger than 255"
+#endif
+
 // For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
 // #define BENCH_KEY_OVERRIDE
 
@@ -83,6 +91,21 @@ static uint16_t deferred_register = 0;
 // TODO: in future maybe save in EEPROM?
 static bool enabled = true;
 
+#ifdef KEY_OVERRIDE_KEYCODE_INDEX
+// Maps each trigger keycode to the overrides using it. Entries are sorted by trigger and, within a trigger, by position in key_overrides, so candidates are tried in the same order as a walk over the whole array would.
+typedef struct {
+    uint16_t trigger;
+    uint8_t  override_index;
+    // One-sided modifiers that all have to be down, 0 for overrides where a single trigger modifier suffices
+    uint8_t  required_mods;
+} key_override_index_entry_t;
+static key_override_index_entry_t key_override_index[KEY_OVERRIDE_INDEX_LENGTH];
+static uint8_t                    key_override_index_size  = 0;
+static bool                       key_override_index_valid = false;
+// The array the index was built from, so a different key_overrides array is picked up
+static const key_override_t **key_override_index_source = NULL;
+#endif
+
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
@@ -112,6 +135,11 @@ bool key_override_is_enabled(void) {
     return enabled;
 }
 
+// Moves right hand modifiers onto the left hand bits
+static inline uint8_t one_sided_mods(const uint8_t mods) {
+    return (mods & 0b1111) | (mods >> 4);
+}
+
 // Returns whether the modifiers that are pressed are such that the override should activate
 static bool key_override_matches_active_modifiers(const key_override_t *override, const uint8_t mods) {
     // Check that negative keys pass
@@ -131,13 +159,13 @@ static bool key_override_matches_active_modifiers(const key_override_t *override
         // All trigger modifiers must be down, but each mod can be active on either side (if both sides are specified).
 
         // Which mods, regardless of side, are required?
-        uint8_t one_sided_required_mods = (override->trigger_mods & 0b1111) | (override->trigger_mods >> 4);
+        uint8_t one_sided_required_mods = one_sided_mods(override->trigger_mods);
 
         // Which of the required modifiers are active?
         uint8_t active_required_mods = override->trigger_mods & mods;
 
         // Move the active requird mods to one side
-        uint8_t one_sided_active_required_mods = (active_required_mods & 0b1111) | (active_required_mods >> 4);
+        uint8_t one_sided_active_required_mods = one_sided_mods(active_required_mods);
 
         // Check that there is a full match between the required one-sided mods and active required one sided mods
         return one_sided_active_required_mods == one_sided_required_mods;
@@ -245,147 +273,279 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Checks whether the provided override should activate for the key event, i.e. the event is an allowed activation event, the override is enabled for the layer, the mods match and the trigger key is down. */
+static bool should_activate_override(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
+
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
+
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
+
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
+
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
+
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
+
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
+
+    return true;
+}
+
+/** Activates the provided override. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *override, const uint16_t keycode, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    const bool trigger_down = override->trigger == keycode && key_down;
+    const bool no_trigger   = override->trigger == KC_NO;
+
+    key_override_printf("Activating override\n");
+
+    clear_active_override(false);
+
+#ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
+#endif
+
+    active_override                 = override;
+    active_override_trigger_is_down = true;
+
+    set_suppressed_override_mods(override->suppressed_mods);
+
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
         }
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
+
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
+            } else {
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
+            }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
+
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
 
-        const bool is_trigger = override->trigger == keycode;
+#ifdef KEY_OVERRIDE_KEYCODE_INDEX
+void key_override_rebuild_index(void) {
+    key_override_index_size   = 0;
+    key_override_index_valid  = false;
+    key_override_index_source = key_overrides;
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
+    if (key_overrides == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        if (key_override_index_size >= KEY_OVERRIDE_INDEX_LENGTH) {
+            dprintf("key override: index needs more than %d entries, falling back to linear search\n", KEY_OVERRIDE_INDEX_LENGTH);
+            return;
         }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+        const key_override_t *const override = key_overrides[i];
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
+        // Insertion sort by trigger; overrides are visited in ascending order, so inserting after equal triggers keeps each run ordered by position.
+        uint8_t pos = key_override_index_size++;
+        while (pos > 0 && key_override_index[pos - 1].trigger > override->trigger) {
+            key_override_index[pos] = key_override_index[pos - 1];
+            --pos;
         }
+        key_override_index[pos] = (key_override_index_entry_t){
+            .trigger        = override->trigger,
+            .override_index = i,
+            .required_mods  = (override->options & ko_option_one_mod) != 0 ? 0 : one_sided_mods(override->trigger_mods),
+        };
+    }
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
+    key_override_index_valid = true;
+}
+
+// Returns the position of the first index entry for trigger, or the position it would be inserted at if no override uses it.
+static uint8_t key_override_index_find(const uint16_t trigger) {
+    uint8_t lo = 0, hi = key_override_index_size;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
+    }
+    return lo;
+}
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
+/** Tries activating the overrides that can be triggered by the key event, in the order they appear in key_overrides. Only overrides triggered by no key, by `keycode` or by the last key pressed down can activate, so only those runs of the index are merged. */
+static bool try_activating_indexed_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    const uint16_t triggers[] = {KC_NO, keycode, last_key_down};
+    uint8_t        next[3], end[3];
+
+    for (uint8_t t = 0; t < 3; t++) {
+        next[t] = end[t] = 0;
+        // Skip triggers already covered by an earlier run
+        if ((t > 0 && triggers[t] == triggers[0]) || (t > 1 && triggers[t] == triggers[1])) {
             continue;
         }
+        next[t] = key_override_index_find(triggers[t]);
+        end[t]  = next[t];
+        while (end[t] < key_override_index_size && key_override_index[end[t]].trigger == triggers[t]) {
+            end[t]++;
+        }
+    }
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    const uint8_t one_sided_active_mods = one_sided_mods(active_mods);
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    while (true) {
+        // Pick the candidate that comes first in key_overrides
+        int8_t best = -1;
+        for (uint8_t t = 0; t < 3; t++) {
+            if (next[t] < end[t] && (best < 0 || key_override_index[next[t]].override_index < key_override_index[next[best]].override_index)) {
+                best = t;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+
+        const key_override_index_entry_t *const entry = &key_override_index[next[best]++];
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
+        // Cheap mods check without touching the override itself
+        if ((entry->required_mods & ~one_sided_active_mods) != 0) {
             continue;
         }
 
-        key_override_printf("Activating override\n");
+        const key_override_t *const override = key_overrides[entry->override_index];
+        if (should_activate_override(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod, active_mods);
+        }
+    }
 
-        clear_active_override(false);
+    *activated = false;
 
-#ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    return true;
+}
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
-
-        set_suppressed_override_mods(override->suppressed_mods);
+void key_override_init(void) {
+#ifdef KEY_OVERRIDE_KEYCODE_INDEX
+    key_override_rebuild_index();
+#endif
+}
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
-            } else {
-                unregister_code(override->trigger);
-            }
-        }
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_overrides == NULL) {
+        return true;
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+#ifdef KEY_OVERRIDE_KEYCODE_INDEX
+    if (key_override_index_source != key_overrides) {
+        key_override_rebuild_index();
+    }
+    if (key_override_index_valid) {
+        return try_activating_indexed_override(keycode, layer, key_down, is_mod, active_mods, activated);
+    }
+#endif
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+    for (uint8_t i = 0;; i++) {
+        const key_override_t *const override = key_overrides[i];
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+        // End of array
+        if (override == NULL) {
+            break;
         }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
-
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
-            }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+        if (!should_activate_override(override, keycode, layer, key_down, is_mod, active_mods)) {
+            continue;
         }
 
         *activated = true;
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+        return activate_override(override, keycode, key_down, is_mod, active_mods);
     }
 
     *activated = false;
@@ -407,6 +567,15 @@ void key_override_task(void) {
     }
 }
 
+uint32_t key_override_idle_time(void) {
+    if (deferred_register == 0) {
+        return IDLE_TIME_FOREVER;
+    }
+
+    uint32_t elapsed = timer_elapsed32(defer_reference_time);
+    return elapsed >= defer_delay ? 0 : defer_delay - elapsed;
+}
+
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
 #ifdef BENCH_KEY_OVERRIDE
     uint16_t start = timer_read();
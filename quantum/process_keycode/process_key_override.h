@@ -102,12 +102,23 @@ void key_override_toggle(void);
 /** Returns whether key overrides are enabled */
 bool key_override_is_enabled(void);
 
+/** Prepares key override processing, called once during keyboard initialization */
+void key_override_init(void);
+
+#ifdef KEY_OVERRIDE_KEYCODE_INDEX
+/** Rebuilds the lookup table from trigger keycodes to key overrides. Call this after changing the contents of key_overrides at runtime, assigning a different array is picked up automatically */
+void key_override_rebuild_index(void);
+#endif
+
 /** Handling of key overrides and its implemented keycodes */
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record);
 
 /** Perform any deferred keys */
 void key_override_task(void);
 
+/** Returns the number of milliseconds until a deferred key needs to be registered, or IDLE_TIME_FOREVER if none is pending */
+uint32_t key_override_idle_time(void);
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
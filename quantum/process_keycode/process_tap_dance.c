@@ -188,6 +188,17 @@ void tap_dance_task(void) {
     }
 }
 
+uint32_t tap_dance_idle_time(void) {
+    if (!active_td) return IDLE_TIME_FOREVER;
+
+    tap_dance_action_t *action = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(active_td)];
+    if (action->state.interrupted || action->state.finished) return IDLE_TIME_FOREVER;
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    return elapsed > term ? 0 : term + 1 - elapsed;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
@@ -0,0 +1,187 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits.h>
+#include <string.h>
+#include "profiling.h"
+#include "print.h"
+
+static const char *const probe_names[PROFILE_PROBE_COUNT] = {
+#define PROFILE_PROBE(id, name) [PROFILE_PROBE_##id] = name,
+#include "profiling_probes.inc"
+#undef PROFILE_PROBE
+};
+
+static profile_stats_t probe_stats[PROFILE_PROBE_COUNT];
+
+static uint8_t histogram_bucket(uint32_t ticks) {
+    if (ticks == 0) {
+        return 0;
+    }
+
+    uint8_t bucket = sizeof(unsigned long) * CHAR_BIT - __builtin_clzl(ticks);
+    return bucket < PROFILING_HISTOGRAM_BUCKETS ? bucket : PROFILING_HISTOGRAM_BUCKETS - 1;
+}
+
+static uint32_t histogram_bucket_upper_bound(uint8_t bucket) {
+    if (bucket >= 32) {
+        return UINT32_MAX;
+    }
+    return ((uint32_t)1 << bucket) - 1;
+}
+
+void profiling_record(profile_probe_t probe, uint32_t ticks) {
+    if (probe >= PROFILE_PROBE_COUNT) {
+        return;
+    }
+
+    profile_stats_t *stats = &probe_stats[probe];
+    if (stats->count == 0 || ticks < stats->min) {
+        stats->min = ticks;
+    }
+    if (ticks > stats->max) {
+        stats->max = ticks;
+    }
+    if (stats->count < UINT32_MAX) {
+        stats->count++;
+    }
+    stats->sum += ticks;
+
+    uint16_t *bucket = &stats->histogram[histogram_bucket(ticks)];
+    if (*bucket < UINT16_MAX) {
+        (*bucket)++;
+    }
+}
+
+void profiling_reset(void) {
+    memset(probe_stats, 0, sizeof(probe_stats));
+}
+
+const profile_stats_t *profiling_get_stats(profile_probe_t probe) {
+    return probe < PROFILE_PROBE_COUNT ? &probe_stats[probe] : NULL;
+}
+
+const char *profiling_probe_name(profile_probe_t probe) {
+    return probe < PROFILE_PROBE_COUNT ? probe_names[probe] : NULL;
+}
+
+uint32_t profiling_average(profile_probe_t probe) {
+    if (probe >= PROFILE_PROBE_COUNT || probe_stats[probe].count == 0) {
+        return 0;
+    }
+    return probe_stats[probe].sum / probe_stats[probe].count;
+}
+
+uint32_t profiling_percentile(profile_probe_t probe, uint8_t percent) {
+    if (probe >= PROFILE_PROBE_COUNT) {
+        return 0;
+    }
+
+    const profile_stats_t *stats = &probe_stats[probe];
+    uint32_t               total = 0;
+    for (uint8_t i = 0; i < PROFILING_HISTOGRAM_BUCKETS; i++) {
+        total += stats->histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Smallest bucket covering at least percent% of the histogram
+    uint32_t target = ((uint64_t)total * (percent > 100 ? 100 : percent) + 99) / 100;
+    uint32_t seen   = 0;
+    for (uint8_t i = 0; i < PROFILING_HISTOGRAM_BUCKETS; i++) {
+        seen += stats->histogram[i];
+        if (seen >= target) {
+            uint32_t upper_bound = histogram_bucket_upper_bound(i);
+            return upper_bound < stats->max ? upper_bound : stats->max;
+        }
+    }
+    return stats->max;
+}
+
+void profiling_print(void) {
+    uprintf("profile: %lu ticks/s\n", (unsigned long)profiling_timestamp_frequency());
+    for (profile_probe_t probe = 0; probe < PROFILE_PROBE_COUNT; probe++) {
+        const profile_stats_t *stats = &probe_stats[probe];
+        if (stats->count == 0) {
+            continue;
+        }
+        uprintf("%s: n=%lu min=%lu avg=%lu max=%lu p99=%lu\n", probe_names[probe], (unsigned long)stats->count, (unsigned long)stats->min, (unsigned long)profiling_average(probe), (unsigned long)stats->max, (unsigned long)profiling_percentile(probe, 99));
+    }
+}
+
+static void write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+bool profiling_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, profiling_command, probe, ... ]
+    if (length < 32 || data[0] != PROFILING_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_id   = &data[0];
+    uint8_t *command_data = &data[2];
+    uint8_t  probe        = command_data[0];
+
+    switch (data[1]) {
+        case id_profiling_get_info: {
+            // [ probe_count, bucket_count, frequency(4) ]
+            command_data[0] = PROFILE_PROBE_COUNT;
+            command_data[1] = PROFILING_HISTOGRAM_BUCKETS;
+            write_u32(&command_data[2], profiling_timestamp_frequency());
+            break;
+        }
+        case id_profiling_get_stats: {
+            // [ probe, count(4), min(4), avg(4), max(4), p99(4), name... ]
+            if (probe >= PROFILE_PROBE_COUNT) {
+                *command_id = 0xFF;
+                break;
+            }
+            const profile_stats_t *stats = &probe_stats[probe];
+            write_u32(&command_data[1], stats->count);
+            write_u32(&command_data[5], stats->min);
+            write_u32(&command_data[9], profiling_average(probe));
+            write_u32(&command_data[13], stats->max);
+            write_u32(&command_data[17], profiling_percentile(probe, 99));
+            // the name is truncated to fit, and not terminated if it fills the space
+            uint8_t *name      = &command_data[21];
+            size_t   space     = length - (name - data);
+            size_t   name_size = strlen(probe_names[probe]);
+            memset(name, 0, space);
+            memcpy(name, probe_names[probe], name_size < space ? name_size : space);
+            break;
+        }
+        case id_profiling_get_histogram: {
+            // [ probe, first_bucket, bucket_count, counts(2)... ]
+            uint8_t first = command_data[1];
+            if (probe >= PROFILE_PROBE_COUNT || first >= PROFILING_HISTOGRAM_BUCKETS) {
+                *command_id = 0xFF;
+                break;
+            }
+            uint8_t count = (length - 5) / 2;
+            if (count > PROFILING_HISTOGRAM_BUCKETS - first) {
+                count = PROFILING_HISTOGRAM_BUCKETS - first;
+            }
+            command_data[2] = count;
+            for (uint8_t i = 0; i < count; i++) {
+                uint16_t value          = probe_stats[probe].histogram[first + i];
+                command_data[3 + 2 * i] = value >> 8;
+                command_data[4 + 2 * i] = value & 0xFF;
+            }
+            break;
+        }
+        case id_profiling_reset_stats: {
+            profiling_reset();
+            break;
+        }
+        default: {
+            *command_id = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,141 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup profiling Profiling
+ *
+ * Measures the time spent in each task of the main loop using the platform's
+ * cycle counter. Every probe keeps min/avg/max and a log2 histogram in RAM,
+ * which can be printed over the console or read back over raw HID.
+ * \{
+ */
+
+#ifndef PROFILING_HISTOGRAM_BUCKETS
+#    define PROFILING_HISTOGRAM_BUCKETS 24
+#endif
+
+#if PROFILING_HISTOGRAM_BUCKETS < 2 || PROFILING_HISTOGRAM_BUCKETS > 33
+#    error "PROFILING_HISTOGRAM_BUCKETS must be between 2 and 33"
+#endif
+
+#ifndef PROFILING_RAW_HID_COMMAND_ID
+#    define PROFILING_RAW_HID_COMMAND_ID 0xFD
+#endif
+
+typedef enum {
+#define PROFILE_PROBE(id, name) PROFILE_PROBE_##id,
+#include "profiling_probes.inc"
+#undef PROFILE_PROBE
+    PROFILE_PROBE_COUNT,
+} profile_probe_t;
+
+/**
+ * \brief Statistics gathered for a single probe, all durations in timestamp ticks.
+ *
+ * Bucket 0 counts zero length samples, bucket `n` counts samples between
+ * `2^(n-1)` and `2^n - 1` ticks. The last bucket also holds everything longer.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t histogram[PROFILING_HISTOGRAM_BUCKETS];
+} profile_stats_t;
+
+enum profiling_raw_hid_command {
+    id_profiling_get_info      = 0x00,
+    id_profiling_get_stats     = 0x01,
+    id_profiling_get_histogram = 0x02,
+    id_profiling_reset_stats   = 0x03,
+};
+
+/**
+ * \brief Read the platform cycle counter.
+ *
+ * The counter is free running and wraps around, only differences between two
+ * readings are meaningful.
+ */
+uint32_t profiling_timestamp(void);
+
+/**
+ * \brief Number of timestamp ticks per second, or 0 if unknown.
+ */
+uint32_t profiling_timestamp_frequency(void);
+
+/**
+ * \brief Add a sample to the statistics of a probe.
+ *
+ * \param probe The probe to update.
+ * \param ticks The measured duration in timestamp ticks.
+ */
+void profiling_record(profile_probe_t probe, uint32_t ticks);
+
+/**
+ * \brief Clear the statistics of all probes.
+ */
+void profiling_reset(void);
+
+/**
+ * \brief Retrieve the statistics of a probe, or `NULL` if the probe is out of range.
+ */
+const profile_stats_t *profiling_get_stats(profile_probe_t probe);
+
+/**
+ * \brief Retrieve the name of a probe, or `NULL` if the probe is out of range.
+ */
+const char *profiling_probe_name(profile_probe_t probe);
+
+/**
+ * \brief Average duration of a probe in timestamp ticks.
+ */
+uint32_t profiling_average(profile_probe_t probe);
+
+/**
+ * \brief Estimate a percentile from the histogram of a probe.
+ *
+ * The result is the upper bound of the bucket the percentile falls into,
+ * clamped to the longest recorded sample.
+ *
+ * \param probe The probe to query.
+ * \param percent The percentile, e.g. 99.
+ */
+uint32_t profiling_percentile(profile_probe_t probe, uint8_t percent);
+
+/**
+ * \brief Print the statistics of all probes that have samples over the console.
+ */
+void profiling_print(void);
+
+/**
+ * \brief Handle a profiling raw HID request.
+ *
+ * Requests start with `PROFILING_RAW_HID_COMMAND_ID`, followed by one of
+ * `profiling_raw_hid_command`. The response is written back into `data`.
+ *
+ * \return `true` if the request was handled and `data` should be sent back to the host.
+ */
+bool profiling_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#ifdef PROFILING_ENABLE
+#    define PROFILE_TASK(probe, ...)                                                        \
+        do {                                                                                \
+            const uint32_t profile_start = profiling_timestamp();                           \
+            __VA_ARGS__;                                                                    \
+            profiling_record(PROFILE_PROBE_##probe, profiling_timestamp() - profile_start); \
+        } while (0)
+#else
+#    define PROFILE_TASK(probe, ...) \
+        do {                         \
+            __VA_ARGS__;             \
+        } while (0)
+#endif
+
+/** \} */
@@ -23,6 +23,9 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+#    include "synchronization_util.h"
+#endif
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
@@ -86,6 +89,11 @@ static last_hit_t last_hit_buffer;
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+#    ifdef SPLIT_RGB_MATRIX_FRAME_ENABLE
+RGB                  g_rgb_split_frame[RGB_MATRIX_LED_COUNT];
+static RGB           rgb_split_frame_shown[RGB_MATRIX_LED_COUNT]; // copy of g_rgb_split_frame the slave sends to the driver
+static volatile bool rgb_split_frame_received = false;
+#    endif // SPLIT_RGB_MATRIX_FRAME_ENABLE
 #endif
 
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
@@ -144,6 +152,14 @@ void rgb_matrix_update_pwm_buffers(void) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+    // Keep the colors of the other half too, for the split transport to send
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        g_rgb_split_frame[index].r = red;
+        g_rgb_split_frame[index].g = green;
+        g_rgb_split_frame[index].b = blue;
+    }
+#endif
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
@@ -350,7 +366,42 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_task_state = SYNCING;
 }
 
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+bool rgb_matrix_split_frame_ready(void) {
+    return rgb_task_state == SYNCING;
+}
+
+void rgb_matrix_split_frame_received(void) {
+    rgb_split_frame_received = true;
+}
+
+static void rgb_task_split_frame(void) {
+    if (!rgb_split_frame_received || sync_timer_elapsed32(g_rgb_timer) < RGB_MATRIX_LED_FLUSH_LIMIT) return;
+    g_rgb_timer = sync_timer_read32();
+
+    // The transport may apply packets to g_rgb_split_frame from its own thread, so copy it
+    // in one go, instead of reading it LED by LED while the next packet may arrive
+    split_shared_memory_lock();
+    memcpy(rgb_split_frame_shown, g_rgb_split_frame, sizeof(rgb_split_frame_shown));
+    rgb_split_frame_received = false;
+    split_shared_memory_unlock();
+
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_driver.set_color(i, rgb_split_frame_shown[i].r, rgb_split_frame_shown[i].g, rgb_split_frame_shown[i].b);
+    }
+    rgb_matrix_update_pwm_buffers();
+}
+#endif // defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+
 void rgb_matrix_task(void) {
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+    // The slave shows the frames rendered by the master
+    if (!is_keyboard_master()) {
+        rgb_task_split_frame();
+        return;
+    }
+#endif
+
     rgb_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
@@ -385,6 +436,15 @@ void rgb_matrix_task(void) {
     }
 }
 
+uint32_t rgb_matrix_idle_time(void) {
+    if (rgb_task_state != SYNCING) {
+        return 0;
+    }
+
+    uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+    return elapsed >= RGB_MATRIX_LED_FLUSH_LIMIT ? 0 : RGB_MATRIX_LED_FLUSH_LIMIT - elapsed;
+}
+
 void rgb_matrix_indicators(void) {
     rgb_matrix_indicators_kb();
 }
@@ -400,7 +460,7 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
 #if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
-#    if defined(RGB_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_SPLIT) && !defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
@@ -413,7 +473,7 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
-#    if defined(RGB_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_SPLIT) && !defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
     limits.led_min_index                = 0;
     limits.led_max_index                = RGB_MATRIX_LED_COUNT;
     const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
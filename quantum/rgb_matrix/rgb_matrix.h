@@ -150,7 +150,8 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
-void rgb_matrix_task(void);
+void     rgb_matrix_task(void);
+uint32_t rgb_matrix_idle_time(void);
 
 // This runs after another backlight effect and replaces
 // colors already set
@@ -256,7 +257,7 @@ void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 #endif
 
 static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
-#if defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_SPLIT) && !defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
     if (is_keyboard_left()) {
         uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
         return led_idx < k_rgb_matrix_split[0];
@@ -277,3 +278,12 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#if defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+// The colors of both halves, as rendered by the master or received by the slave
+extern RGB g_rgb_split_frame[RGB_MATRIX_LED_COUNT];
+
+// Whether the master has finished rendering the current frame
+bool rgb_matrix_split_frame_ready(void);
+// Marks g_rgb_split_frame as updated by the split transport, for the slave to show it
+void rgb_matrix_split_frame_received(void);
+#endif
@@ -0,0 +1,122 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix_split_frame.h"
+
+static inline bool same_color(const RGB *a, const RGB *b) {
+    return a->r == b->r && a->g == b->g && a->b == b->b;
+}
+
+static inline void write_color(uint8_t *data, const RGB *color) {
+    data[0] = color->r;
+    data[1] = color->g;
+    data[2] = color->b;
+}
+
+static inline void read_color(RGB *color, const uint8_t *data) {
+    color->r = data[0];
+    color->g = data[1];
+    color->b = data[2];
+}
+
+// Encodes the LEDs from start to end, returns false with *stop set to the first LED left out if the packet filled up
+static bool encode_range(const RGB *frame, const RGB *shadow, uint8_t start, uint8_t end, bool all, uint8_t *packet, uint8_t size, uint8_t *length, uint8_t *stop) {
+    uint8_t i = start;
+    while (i < end) {
+        if (!all && same_color(&frame[i], &shadow[i])) {
+            i++;
+            continue;
+        }
+
+        uint8_t run_end = i + 1;
+        while (run_end < end && (all || !same_color(&frame[run_end], &shadow[run_end]))) {
+            run_end++;
+        }
+
+        while (i < run_end) {
+            uint8_t fill = 1;
+            while (i + fill < run_end && fill < RGB_MATRIX_SPLIT_FRAME_MAX_RUN && same_color(&frame[i + fill], &frame[i])) {
+                fill++;
+            }
+
+            if (fill > 1) {
+                if (*length + 5 > size) {
+                    *stop = i;
+                    return false;
+                }
+                packet[*length]     = i;
+                packet[*length + 1] = RGB_MATRIX_SPLIT_FRAME_FILL | fill;
+                write_color(&packet[*length + 2], &frame[i]);
+                *length += 5;
+                i += fill;
+                continue;
+            }
+
+            // Colors one by one, up to the next pair that can be filled
+            uint8_t literal = 1;
+            while (i + literal < run_end && literal < RGB_MATRIX_SPLIT_FRAME_MAX_RUN && !(i + literal + 1 < run_end && same_color(&frame[i + literal], &frame[i + literal + 1]))) {
+                literal++;
+            }
+
+            uint8_t space = *length + 5 <= size ? (size - *length - 2) / 3 : 0;
+            if (space == 0) {
+                *stop = i;
+                return false;
+            }
+
+            bool truncated = literal > space;
+            if (truncated) {
+                literal = space;
+            }
+            packet[*length]     = i;
+            packet[*length + 1] = literal;
+            for (uint8_t n = 0; n < literal; n++) {
+                write_color(&packet[*length + 2 + 3 * n], &frame[i + n]);
+            }
+            *length += 2 + 3 * literal;
+            i += literal;
+
+            if (truncated) {
+                *stop = i;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint8_t rgb_matrix_split_frame_encode(const RGB *frame, const RGB *shadow, uint8_t count, bool all, uint8_t *cursor, uint8_t *packet, uint8_t size) {
+    uint8_t length = 0;
+    uint8_t start  = *cursor < count ? *cursor : 0;
+    uint8_t stop;
+
+    if (!encode_range(frame, shadow, start, count, all, packet, size, &length, &stop) || !encode_range(frame, shadow, 0, start, all, packet, size, &length, &stop)) {
+        *cursor = stop;
+    }
+    return length;
+}
+
+bool rgb_matrix_split_frame_decode(const uint8_t *packet, uint8_t length, RGB *frame, uint8_t count) {
+    uint16_t i = 0;
+    while (i < length) {
+        if (length - i < 2) {
+            return false;
+        }
+
+        uint8_t  first  = packet[i];
+        uint8_t  header = packet[i + 1];
+        uint8_t  run    = header & RGB_MATRIX_SPLIT_FRAME_MAX_RUN;
+        bool     fill   = header & RGB_MATRIX_SPLIT_FRAME_FILL;
+        uint16_t need   = fill ? 3 : 3 * run;
+        i += 2;
+
+        if (length - i < need || first + run > count) {
+            return false;
+        }
+        for (uint8_t n = 0; n < run; n++) {
+            read_color(&frame[first + n], &packet[fill ? i : i + 3 * n]);
+        }
+        i += need;
+    }
+    return true;
+}
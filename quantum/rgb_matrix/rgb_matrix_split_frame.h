@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "color.h"
+
+/*
+Delta encoding of the LED frames the master streams to the slave half.
+
+A packet is a list of runs, each starting with the index of its first LED and a
+header byte. If bit 7 of the header is set, a single color follows for the next
+(header & 0x7F) LEDs, otherwise header colors follow, one per LED. Colors are
+sent as red, green and blue.
+*/
+
+#define RGB_MATRIX_SPLIT_FRAME_FILL 0x80
+#define RGB_MATRIX_SPLIT_FRAME_MAX_RUN 0x7F
+
+/**
+ * \brief Encode the LEDs that differ between a frame and the one the slave has.
+ *
+ * Encoding starts at `*cursor` and wraps around. When the packet runs out of
+ * space, `*cursor` is moved to the first LED that was left out, so that the
+ * next packet picks up from there.
+ *
+ * \param frame The frame to send.
+ * \param shadow The frame the slave has, it is not modified.
+ * \param count The number of LEDs in both frames.
+ * \param all Encode every LED, not only the ones that differ.
+ * \param cursor The LED to start at.
+ * \param packet The buffer to encode into.
+ * \param size The size of the buffer.
+ *
+ * \return The length of the packet, or 0 if there is nothing to send.
+ */
+uint8_t rgb_matrix_split_frame_encode(const RGB *frame, const RGB *shadow, uint8_t count, bool all, uint8_t *cursor, uint8_t *packet, uint8_t size);
+
+/**
+ * \brief Apply a packet to a frame.
+ *
+ * Runs are applied up to the first one that does not fit into the packet or
+ * into the frame.
+ *
+ * \return `false` if not all of the packet could be applied.
+ */
+bool rgb_matrix_split_frame_decode(const uint8_t *packet, uint8_t length, RGB *frame, uint8_t count);
@@ -0,0 +1,176 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+extern "C" {
+#include "rgb_matrix_split_frame.h"
+}
+
+static RGB color(uint8_t r, uint8_t g, uint8_t b) {
+    RGB c = {};
+    c.r   = r;
+    c.g   = g;
+    c.b   = b;
+    return c;
+}
+
+static bool same_frame(const std::vector<RGB> &a, const std::vector<RGB> &b) {
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].r != b[i].r || a[i].g != b[i].g || a[i].b != b[i].b) return false;
+    }
+    return true;
+}
+
+// Sends packets until the shadow matches the frame, returns the number of packets
+static int sync_frame(const std::vector<RGB> &frame, std::vector<RGB> &shadow, uint8_t *cursor, uint8_t size) {
+    uint8_t packet[255];
+    int     packets = 0;
+    while (uint8_t length = rgb_matrix_split_frame_encode(frame.data(), shadow.data(), frame.size(), false, cursor, packet, size)) {
+        EXPECT_LE(length, size);
+        EXPECT_TRUE(rgb_matrix_split_frame_decode(packet, length, shadow.data(), shadow.size()));
+        if (++packets > 255) break;
+    }
+    return packets;
+}
+
+TEST(RgbMatrixSplitFrame, EncodesNothingForUnchangedFrame) {
+    std::vector<RGB> frame(20, color(1, 2, 3));
+    uint8_t          packet[32];
+    uint8_t          cursor = 0;
+
+    EXPECT_EQ(rgb_matrix_split_frame_encode(frame.data(), frame.data(), frame.size(), false, &cursor, packet, sizeof(packet)), 0);
+    EXPECT_EQ(cursor, 0);
+}
+
+TEST(RgbMatrixSplitFrame, EncodesChangedLedsOnly) {
+    std::vector<RGB> shadow(10, color(0, 0, 0));
+    std::vector<RGB> frame = shadow;
+    uint8_t          packet[32];
+    uint8_t          cursor = 0;
+
+    frame[2] = color(255, 0, 0);
+    frame[3] = color(0, 0, 255);
+    frame[4] = color(0, 0, 255);
+    frame[5] = color(0, 0, 255);
+    frame[7] = color(1, 2, 3);
+    frame[8] = color(4, 5, 6);
+
+    // clang-format off
+    const uint8_t expected[] = {
+        2, 1, 255, 0, 0,
+        3, RGB_MATRIX_SPLIT_FRAME_FILL | 3, 0, 0, 255,
+        7, 2, 1, 2, 3, 4, 5, 6,
+    };
+    // clang-format on
+
+    ASSERT_EQ(rgb_matrix_split_frame_encode(frame.data(), shadow.data(), frame.size(), false, &cursor, packet, sizeof(packet)), sizeof(expected));
+    EXPECT_EQ(memcmp(packet, expected, sizeof(expected)), 0);
+
+    EXPECT_TRUE(rgb_matrix_split_frame_decode(packet, sizeof(expected), shadow.data(), shadow.size()));
+    EXPECT_TRUE(same_frame(frame, shadow));
+}
+
+TEST(RgbMatrixSplitFrame, FillsWholeFrameOfOneColor) {
+    std::vector<RGB> shadow(100, color(0, 0, 0));
+    std::vector<RGB> frame(100, color(10, 20, 30));
+    uint8_t          cursor = 0;
+
+    EXPECT_EQ(sync_frame(frame, shadow, &cursor, 8), 1);
+    EXPECT_TRUE(same_frame(frame, shadow));
+}
+
+TEST(RgbMatrixSplitFrame, SplitsFrameOverBudget) {
+    std::vector<RGB> shadow(60, color(0, 0, 0));
+    std::vector<RGB> frame(60);
+    uint8_t          cursor = 0;
+
+    for (size_t i = 0; i < frame.size(); i++) {
+        frame[i] = color(i, i * 2, i * 3);
+    }
+
+    // 10 colors fit into a packet of 32 bytes
+    EXPECT_EQ(sync_frame(frame, shadow, &cursor, 32), 6);
+    EXPECT_TRUE(same_frame(frame, shadow));
+}
+
+TEST(RgbMatrixSplitFrame, ResumesAtCursor) {
+    std::vector<RGB> shadow(12, color(0, 0, 0));
+    std::vector<RGB> frame(12);
+    uint8_t          packet[11];
+    uint8_t          cursor = 0;
+
+    for (size_t i = 0; i < frame.size(); i++) {
+        frame[i] = color(i + 1, 0, 0);
+    }
+
+    // Room for 3 colors per packet
+    uint8_t length = rgb_matrix_split_frame_encode(frame.data(), shadow.data(), frame.size(), false, &cursor, packet, sizeof(packet));
+    EXPECT_EQ(length, 11);
+    EXPECT_EQ(packet[0], 0);
+    EXPECT_EQ(cursor, 3);
+    rgb_matrix_split_frame_decode(packet, length, shadow.data(), shadow.size());
+
+    // LEDs that keep changing at the start do not hold back the rest
+    frame[0] = color(99, 0, 0);
+    length   = rgb_matrix_split_frame_encode(frame.data(), shadow.data(), frame.size(), false, &cursor, packet, sizeof(packet));
+    EXPECT_EQ(packet[0], 3);
+    EXPECT_EQ(cursor, 6);
+}
+
+TEST(RgbMatrixSplitFrame, EncodesUnchangedLedsWhenAskedTo) {
+    std::vector<RGB> frame(6);
+    std::vector<RGB> received(6, color(0, 0, 0));
+    uint8_t          packet[32];
+    uint8_t          cursor = 4;
+
+    for (size_t i = 0; i < frame.size(); i++) {
+        frame[i] = color(0, i, 0);
+    }
+
+    uint8_t length = rgb_matrix_split_frame_encode(frame.data(), frame.data(), frame.size(), true, &cursor, packet, sizeof(packet));
+    EXPECT_GT(length, 0);
+    EXPECT_EQ(packet[0], 4);
+    EXPECT_TRUE(rgb_matrix_split_frame_decode(packet, length, received.data(), received.size()));
+    EXPECT_TRUE(same_frame(frame, received));
+}
+
+TEST(RgbMatrixSplitFrame, RoundTripsRandomFrames) {
+    std::vector<RGB> frame(72, color(0, 0, 0));
+    std::vector<RGB> shadow = frame;
+    uint8_t          cursor = 0;
+
+    srand(2024);
+    for (int i = 0; i < 500; i++) {
+        // Change a few LEDs, sometimes a block of one color
+        int changes = rand() % 8;
+        for (int n = 0; n < changes; n++) {
+            int first = rand() % frame.size();
+            int last  = rand() % 4 == 0 ? std::min<int>(frame.size(), first + rand() % 16) : first + 1;
+            RGB c     = color(rand(), rand(), rand());
+            for (int led = first; led < last; led++) {
+                frame[led] = rand() % 2 ? c : color(rand(), rand(), rand());
+            }
+        }
+
+        sync_frame(frame, shadow, &cursor, 24);
+        ASSERT_TRUE(same_frame(frame, shadow)) << "iteration " << i;
+    }
+}
+
+TEST(RgbMatrixSplitFrame, RejectsMalformedPackets) {
+    std::vector<RGB> frame(4, color(0, 0, 0));
+
+    const uint8_t past_end[] = {3, 2, 1, 1, 1, 2, 2, 2};
+    EXPECT_FALSE(rgb_matrix_split_frame_decode(past_end, sizeof(past_end), frame.data(), frame.size()));
+
+    const uint8_t short_colors[] = {0, 2, 1, 1, 1, 2};
+    EXPECT_FALSE(rgb_matrix_split_frame_decode(short_colors, sizeof(short_colors), frame.data(), frame.size()));
+
+    const uint8_t short_header[] = {0, RGB_MATRIX_SPLIT_FRAME_FILL | 4, 5, 5, 5, 1};
+    EXPECT_FALSE(rgb_matrix_split_frame_decode(short_header, sizeof(short_header), frame.data(), frame.size()));
+    // Runs before the broken one are still applied
+    EXPECT_EQ(frame[3].r, 5);
+}
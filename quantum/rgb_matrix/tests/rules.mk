@@ -0,0 +1,5 @@
+rgb_matrix_split_frame_INC := $(QUANTUM_PATH)/rgb_matrix
+
+rgb_matrix_split_frame_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_matrix_split_frame_tests.cpp \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix_split_frame.c
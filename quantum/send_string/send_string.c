@@ -18,11 +18,15 @@
 
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC
+#    include "timer.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -340,3 +344,237 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#    endif
+
+// Key actions are stored as the keycode, with this bit set for presses
+#    define SS_ASYNC_PRESS 0x100
+// Enough actions for a shifted, AltGr'd dead key character
+#    define SS_ASYNC_MAX_ACTIONS 8
+
+// Queued strings, each stored as its interval followed by the null-terminated string
+static char     ss_async_buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t ss_async_head  = 0;
+static uint16_t ss_async_count = 0;
+// Whether the interval of the string at the head of the queue has been read
+static bool    ss_async_in_string = false;
+static uint8_t ss_async_interval  = 0;
+// Key actions of the character currently being typed
+static uint16_t ss_async_actions[SS_ASYNC_MAX_ACTIONS];
+static uint8_t  ss_async_action_count = 0;
+static uint8_t  ss_async_action_index = 0;
+// Time to wait before the next action
+static uint32_t ss_async_timer = 0;
+static uint32_t ss_async_wait  = 0;
+// Basic keycodes currently held down by the queue, released on cancel
+static uint8_t ss_async_pressed[32];
+
+static void ss_async_push(char c) {
+    ss_async_buffer[(ss_async_head + ss_async_count) % SEND_STRING_ASYNC_BUFFER_SIZE] = c;
+    ss_async_count++;
+}
+
+static char ss_async_pop(void) {
+    char c        = ss_async_buffer[ss_async_head];
+    ss_async_head = (ss_async_head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    ss_async_count--;
+    return c;
+}
+
+static void ss_async_add_action(uint8_t keycode, bool pressed) {
+    ss_async_actions[ss_async_action_count++] = keycode | (pressed ? SS_ASYNC_PRESS : 0);
+}
+
+static void ss_async_add_char(char ascii_code) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) {
+        ss_async_add_action(KC_LEFT_SHIFT, true);
+    }
+    if (is_altgred) {
+        ss_async_add_action(KC_RIGHT_ALT, true);
+    }
+    ss_async_add_action(keycode, true);
+    ss_async_add_action(keycode, false);
+    if (is_altgred) {
+        ss_async_add_action(KC_RIGHT_ALT, false);
+    }
+    if (is_shifted) {
+        ss_async_add_action(KC_LEFT_SHIFT, false);
+    }
+    if (is_dead) {
+        ss_async_add_action(KC_SPACE, true);
+        ss_async_add_action(KC_SPACE, false);
+    }
+}
+
+/**
+ * Decodes the next character or special sequence from the queue into key actions, or a delay.
+ *
+ * \return false if the queue is empty.
+ */
+static bool ss_async_decode_next(void) {
+    ss_async_action_count = 0;
+    ss_async_action_index = 0;
+
+    while (ss_async_count > 0) {
+        if (!ss_async_in_string) {
+            ss_async_interval  = ss_async_pop();
+            ss_async_in_string = true;
+            continue;
+        }
+
+        char ascii_code = ss_async_pop();
+        if (!ascii_code) {
+            ss_async_in_string = false;
+            continue;
+        }
+
+        if (ascii_code == SS_QMK_PREFIX) {
+            ascii_code = ss_async_pop();
+            if (ascii_code == SS_TAP_CODE) {
+                uint8_t keycode = ss_async_pop();
+                ss_async_add_action(keycode, true);
+                ss_async_add_action(keycode, false);
+            } else if (ascii_code == SS_DOWN_CODE) {
+                ss_async_add_action(ss_async_pop(), true);
+            } else if (ascii_code == SS_UP_CODE) {
+                ss_async_add_action(ss_async_pop(), false);
+            } else if (ascii_code == SS_DELAY_CODE) {
+                uint32_t ms      = 0;
+                char     keycode = ss_async_pop();
+                while (isdigit(keycode)) {
+                    ms *= 10;
+                    ms += keycode - '0';
+                    keycode = ss_async_pop();
+                }
+                if (!keycode) {
+                    ss_async_in_string = false;
+                }
+                ss_async_timer = timer_read32();
+                ss_async_wait  = ms + ss_async_interval;
+            } else if (!ascii_code) {
+                ss_async_in_string = false;
+            }
+        } else {
+            ss_async_add_char(ascii_code);
+        }
+
+        // Drop the terminator straight away, so the space is available to new strings
+        if (ss_async_in_string && ss_async_count > 0 && !ss_async_buffer[ss_async_head]) {
+            ss_async_pop();
+            ss_async_in_string = false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    size_t length = strlen(string);
+    if (length + 2 > (size_t)(SEND_STRING_ASYNC_BUFFER_SIZE - ss_async_count)) {
+        return false;
+    }
+
+    ss_async_push(interval);
+    while (*string) {
+        ss_async_push(*string++);
+    }
+    ss_async_push(0);
+    return true;
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string) {
+    return send_string_async_with_delay_P(string, 0);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    size_t length = strlen_P(string);
+    if (length + 2 > (size_t)(SEND_STRING_ASYNC_BUFFER_SIZE - ss_async_count)) {
+        return false;
+    }
+
+    ss_async_push(interval);
+    char ascii_code;
+    while ((ascii_code = pgm_read_byte(string++))) {
+        ss_async_push(ascii_code);
+    }
+    ss_async_push(0);
+    return true;
+}
+#    endif
+
+bool send_string_async_is_busy(void) {
+    return ss_async_count > 0 || ss_async_action_index < ss_async_action_count || (ss_async_wait && timer_elapsed32(ss_async_timer) < ss_async_wait);
+}
+
+uint16_t send_string_async_queued(void) {
+    return ss_async_count;
+}
+
+void send_string_async_cancel(void) {
+    ss_async_head         = 0;
+    ss_async_count        = 0;
+    ss_async_in_string    = false;
+    ss_async_action_count = 0;
+    ss_async_action_index = 0;
+    ss_async_wait         = 0;
+
+    for (uint16_t keycode = 0; keycode < 256; keycode++) {
+        if (ss_async_pressed[keycode / 8] & (1 << (keycode % 8))) {
+            unregister_code(keycode);
+        }
+    }
+    memset(ss_async_pressed, 0, sizeof(ss_async_pressed));
+}
+
+void send_string_async_task(void) {
+    if (ss_async_wait) {
+        if (timer_elapsed32(ss_async_timer) < ss_async_wait) {
+            return;
+        }
+        ss_async_wait = 0;
+    }
+
+    if (ss_async_action_index >= ss_async_action_count && !ss_async_decode_next()) {
+        return;
+    }
+    if (ss_async_action_index >= ss_async_action_count) {
+        // Nothing to type, eg. a delay
+        return;
+    }
+
+    uint16_t action  = ss_async_actions[ss_async_action_index++];
+    uint8_t  keycode = action & 0xFF;
+    if (action & SS_ASYNC_PRESS) {
+        register_code(keycode);
+        ss_async_pressed[keycode / 8] |= (1 << (keycode % 8));
+    } else {
+        unregister_code(keycode);
+        ss_async_pressed[keycode / 8] &= ~(1 << (keycode % 8));
+    }
+
+    if (ss_async_interval) {
+        ss_async_timer = timer_read32();
+        ss_async_wait  = ss_async_interval;
+    }
+}
+#endif // SEND_STRING_ASYNC
@@ -24,6 +24,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -161,4 +162,78 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * This function simply calls `send_string_async_with_delay(string, TAP_CODE_DELAY)`.
+ *
+ * \param string The string to type out.
+ *
+ * \return false if there isn't enough room in the queue for the string.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background, with a delay between each key action.
+ *
+ * The string is copied into a queue of `SEND_STRING_ASYNC_BUFFER_SIZE` bytes, and typed out one key press or release at a time from the
+ * main loop, so keys pressed in the meantime are still processed. Delays from `SS_DELAY()` don't block either.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait in between key actions.
+ *
+ * \return false if there isn't enough room in the queue for the string.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, 0).
+ *
+ * \param string The string to type out.
+ *
+ * \return false if there isn't enough room in the queue for the string.
+ */
+bool send_string_async_P(const char *string);
+
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background, with a delay between each key action.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait in between key actions.
+ *
+ * \return false if there isn't enough room in the queue for the string.
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_P(string) send_string_async_with_delay(string, 0)
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Whether queued strings are still being typed out.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief The number of bytes waiting in the queue.
+ */
+uint16_t send_string_async_queued(void);
+
+/**
+ * \brief Drop all queued strings, and release any keys they are holding down.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Types out the next key action of the queued strings, when due. Called from the main loop.
+ */
+void send_string_async_task(void);
+#endif
+
 /** \} */
@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 6
+
+#define NUM_ENCODERS_LEFT 2
+#define NUM_ENCODERS_RIGHT 2
+
+#define SPLIT_KEYBOARD
+#define SPLIT_TRANSPORT_MIRROR
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_LED_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_ACTIVITY_ENABLE
+#define SPLIT_TRANSACTION_IDS_USER USER_ECHO, USER_ASYNC
+
+#ifdef RGB_MATRIX_ENABLE
+#    define RGB_MATRIX_LED_COUNT 10
+#    define RGB_MATRIX_SPLIT \
+        { 4, 6 }
+#endif
@@ -0,0 +1,194 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "mock_split.h"
+#include "action_util.h"
+#include "keyboard.h"
+#include "sync_timer.h"
+#include "split_util.h"
+#include "transport.h"
+#include "transactions.h"
+
+mock_split_half_t mock_master;
+mock_split_half_t mock_target;
+bool              mock_transport_connected = true;
+
+static mock_split_half_t       *current = &mock_master;
+static split_shared_memory_t    inactive_memory;
+static split_transaction_desc_t inactive_table[NUM_TOTAL_TRANSACTIONS];
+static split_transaction_desc_t initial_table[NUM_TOTAL_TRANSACTIONS];
+static bool                     initial_table_saved = false;
+
+layer_state_t layer_state;
+layer_state_t default_layer_state;
+#ifdef RGB_MATRIX_ENABLE
+rgb_config_t rgb_matrix_config;
+RGB          g_rgb_split_frame[RGB_MATRIX_LED_COUNT];
+#endif
+
+void mock_split_reset(void) {
+    // The first call sees the transaction table as it was built
+    if (!initial_table_saved) {
+        memcpy(initial_table, split_transaction_table, sizeof(initial_table));
+        initial_table_saved = true;
+    }
+    memcpy(split_transaction_table, initial_table, sizeof(initial_table));
+    memcpy(inactive_table, initial_table, sizeof(initial_table));
+
+    memset(&mock_master, 0, sizeof(mock_master));
+    memset(&mock_target, 0, sizeof(mock_target));
+    mock_transport_connected = true;
+    layer_state         = 0;
+    default_layer_state = 0;
+#ifdef RGB_MATRIX_ENABLE
+    memset(&rgb_matrix_config, 0, sizeof(rgb_matrix_config));
+    memset(g_rgb_split_frame, 0, sizeof(g_rgb_split_frame));
+#endif
+}
+
+void mock_split_reset_target(void) {
+    memset(&mock_target, 0, sizeof(mock_target));
+    memset(&inactive_memory, 0, sizeof(inactive_memory));
+    memcpy(inactive_table, initial_table, sizeof(initial_table));
+}
+
+void mock_split_swap_halves(void) {
+    split_shared_memory_t memory;
+    memcpy(&memory, split_shmem, sizeof(memory));
+    memcpy(split_shmem, &inactive_memory, sizeof(memory));
+    memcpy(&inactive_memory, &memory, sizeof(memory));
+
+    split_transaction_desc_t table[NUM_TOTAL_TRANSACTIONS];
+    memcpy(table, split_transaction_table, sizeof(table));
+    memcpy(split_transaction_table, inactive_table, sizeof(table));
+    memcpy(inactive_table, table, sizeof(table));
+
+    current->layer_state         = layer_state;
+    current->default_layer_state = default_layer_state;
+#ifdef RGB_MATRIX_ENABLE
+    current->rgb_matrix_config = rgb_matrix_config;
+    memcpy(current->rgb_frame, g_rgb_split_frame, sizeof(g_rgb_split_frame));
+#endif
+    current             = current == &mock_master ? &mock_target : &mock_master;
+    layer_state         = current->layer_state;
+    default_layer_state = current->default_layer_state;
+#ifdef RGB_MATRIX_ENABLE
+    rgb_matrix_config = current->rgb_matrix_config;
+    memcpy(g_rgb_split_frame, current->rgb_frame, sizeof(g_rgb_split_frame));
+#endif
+}
+
+bool is_transport_connected(void) {
+    return mock_transport_connected;
+}
+
+uint8_t get_mods(void) {
+    return current->real_mods;
+}
+void set_mods(uint8_t mods) {
+    current->real_mods = mods;
+}
+uint8_t get_weak_mods(void) {
+    return current->weak_mods;
+}
+void set_weak_mods(uint8_t mods) {
+    current->weak_mods = mods;
+}
+uint8_t get_oneshot_mods(void) {
+    return current->oneshot_mods;
+}
+void set_oneshot_mods(uint8_t mods) {
+    current->oneshot_mods = mods;
+}
+
+uint8_t host_keyboard_leds(void) {
+    return current->led_state;
+}
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    current->led_state = led_state;
+}
+
+uint32_t sync_timer_read32(void) {
+    return timer_read32();
+}
+void sync_timer_update(uint32_t time) {
+    current->sync_timer = time;
+    current->sync_timer_updates++;
+}
+
+uint32_t last_matrix_activity_time(void) {
+    return current->activity[0];
+}
+uint32_t last_encoder_activity_time(void) {
+    return current->activity[1];
+}
+uint32_t last_pointing_device_activity_time(void) {
+    return current->activity[2];
+}
+void set_activity_timestamps(uint32_t matrix_timestamp, uint32_t encoder_timestamp, uint32_t pointing_device_timestamp) {
+    current->activity[0] = matrix_timestamp;
+    current->activity[1] = encoder_timestamp;
+    current->activity[2] = pointing_device_timestamp;
+}
+
+bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
+    if (events->head == (events->tail + MAX_QUEUED_ENCODER_EVENTS - 1) % MAX_QUEUED_ENCODER_EVENTS) {
+        return false;
+    }
+    encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0};
+    events->queue[events->head] = new_event;
+    events->head                = (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    events->enqueued++;
+    return true;
+}
+
+bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
+    if (events->head == events->tail) {
+        return false;
+    }
+    encoder_event_t event = events->queue[events->tail];
+    *index                = event.index;
+    *clockwise            = event.clockwise;
+    events->tail          = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    events->dequeued++;
+    return true;
+}
+
+bool encoder_queue_event(uint8_t index, bool clockwise) {
+    return encoder_queue_event_advanced(&current->encoder_events, index, clockwise);
+}
+
+void encoder_retrieve_events(encoder_events_t *events) {
+    memcpy(events, &current->encoder_events, sizeof(encoder_events_t));
+}
+
+void encoder_signal_queue_drain(void) {
+    current->encoder_events.tail     = current->encoder_events.head;
+    current->encoder_events.dequeued = current->encoder_events.enqueued;
+    current->encoder_drains++;
+}
+
+#ifdef RGB_MATRIX_ENABLE
+// The master is the left half
+bool is_keyboard_master(void) {
+    return current == &mock_master;
+}
+bool is_keyboard_left(void) {
+    return current == &mock_master;
+}
+
+bool rgb_matrix_get_suspend_state(void) {
+    return current->rgb_suspend_state;
+}
+void rgb_matrix_set_suspend_state(bool state) {
+    current->rgb_suspend_state = state;
+}
+
+bool rgb_matrix_split_frame_ready(void) {
+    return !current->rgb_frame_busy;
+}
+void rgb_matrix_split_frame_received(void) {
+    current->rgb_frames_received++;
+}
+#endif
@@ -0,0 +1,66 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action_layer.h"
+#include "encoder.h"
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+
+/*
+ * Both halves run in the same process. Each half has its own keyboard state
+ * and its own copy of the split shared memory and transaction table; the
+ * loopback transport swaps them in while the target half handles a
+ * transaction.
+ */
+typedef struct {
+    layer_state_t    layer_state;
+    layer_state_t    default_layer_state;
+    uint8_t          real_mods;
+    uint8_t          weak_mods;
+    uint8_t          oneshot_mods;
+    uint8_t          led_state;
+    uint32_t         sync_timer;
+    uint32_t         sync_timer_updates;
+    uint32_t         activity[3];
+    encoder_events_t encoder_events;
+    uint32_t         encoder_drains;
+#ifdef RGB_MATRIX_ENABLE
+    rgb_config_t rgb_matrix_config;
+    bool         rgb_suspend_state;
+    RGB          rgb_frame[RGB_MATRIX_LED_COUNT];
+    bool         rgb_frame_busy; // rendering, the frame is not complete
+    uint32_t     rgb_frames_received;
+#endif
+} mock_split_half_t;
+
+extern mock_split_half_t mock_master;
+extern mock_split_half_t mock_target;
+
+// Returned by is_transport_connected()
+extern bool mock_transport_connected;
+
+void mock_split_reset(void);
+
+// As if the target half was reset, its transaction table is back to how it was built
+void mock_split_reset_target(void);
+
+// Swaps the target half in or out
+void mock_split_swap_halves(void);
+
+typedef struct {
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t desyncs; // transfers that left bytes the target did not expect on the line
+} serial_loopback_stats_t;
+
+extern serial_loopback_stats_t serial_loopback_stats;
+
+// Fails the next count transfers
+void serial_loopback_fail(uint32_t count);
+// Fails the next count transfers of one transaction
+void serial_loopback_fail_transaction(int8_t id, uint32_t count);
@@ -0,0 +1,48 @@
+split_transactions_DEFS := -DENCODER_ENABLE
+split_transactions_INC := $(QUANTUM_PATH)/split_common
+split_transactions_CONFIG := $(QUANTUM_PATH)/split_common/tests/config.h
+
+split_transactions_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/transactions_tests.cpp \
+	$(QUANTUM_PATH)/split_common/tests/serial_loopback.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_split.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+split_transactions_batch_DEFS := $(split_transactions_DEFS) -DSPLIT_TRANSACTION_BATCH -DSPLIT_TRANSACTION_BATCH_EXPECTED
+split_transactions_batch_INC := $(split_transactions_INC)
+split_transactions_batch_CONFIG := $(split_transactions_CONFIG)
+split_transactions_batch_SRC := $(split_transactions_SRC)
+
+# Larger than the derived default, so the batches only use part of the buffers
+split_transactions_batch_size_DEFS := $(split_transactions_batch_DEFS) -DSPLIT_TRANSACTION_BATCH_SIZE=96
+split_transactions_batch_size_INC := $(split_transactions_INC)
+split_transactions_batch_size_CONFIG := $(split_transactions_CONFIG)
+split_transactions_batch_size_SRC := $(split_transactions_SRC)
+
+split_transactions_matrix_sequence_DEFS := $(split_transactions_DEFS) -DSPLIT_MATRIX_SEQUENCE
+split_transactions_matrix_sequence_INC := $(split_transactions_INC)
+split_transactions_matrix_sequence_CONFIG := $(split_transactions_CONFIG)
+split_transactions_matrix_sequence_SRC := $(split_transactions_SRC)
+
+split_transactions_rpc_fused_DEFS := $(split_transactions_DEFS) -DSPLIT_TRANSACTION_RPC_FUSED
+split_transactions_rpc_fused_INC := $(split_transactions_INC)
+split_transactions_rpc_fused_CONFIG := $(split_transactions_CONFIG)
+split_transactions_rpc_fused_SRC := $(split_transactions_SRC)
+
+split_transactions_stats_DEFS := $(split_transactions_DEFS) -DSPLIT_TRANSACTION_STATS_ENABLE
+split_transactions_stats_INC := $(split_transactions_INC)
+split_transactions_stats_CONFIG := $(split_transactions_CONFIG)
+split_transactions_stats_SRC := \
+	$(split_transactions_SRC) \
+	$(QUANTUM_PATH)/split_common/transaction_stats.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/profiling_timestamp.c
+
+split_transactions_rgb_matrix_frame_DEFS := $(split_transactions_DEFS) -DRGB_MATRIX_ENABLE -DSPLIT_RGB_MATRIX_FRAME_ENABLE -DSPLIT_RGB_MATRIX_FRAME_SIZE=11
+split_transactions_rgb_matrix_frame_INC := $(split_transactions_INC) $(QUANTUM_PATH)/rgb_matrix $(QUANTUM_PATH)/rgb_matrix/animations
+split_transactions_rgb_matrix_frame_CONFIG := $(split_transactions_CONFIG)
+split_transactions_rgb_matrix_frame_SRC := \
+	$(split_transactions_SRC) \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix_split_frame.c
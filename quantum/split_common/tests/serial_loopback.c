@@ -0,0 +1,81 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "serial.h"
+#include "transactions.h"
+#include "mock_split.h"
+
+/*
+ * Host side stand-in for the serial driver: runs the target half of each
+ * transaction in the same process, in the order serial_protocol.c does. Each
+ * half uses the buffer sizes from its own transaction table; if the target
+ * expects more than the master sends, or sends less than the master expects,
+ * the transfer times out.
+ */
+
+serial_loopback_stats_t serial_loopback_stats;
+
+static uint32_t failures;
+static int8_t   failing_transaction = -1;
+static uint32_t transaction_failures;
+
+void serial_loopback_fail(uint32_t count) {
+    failures = count;
+}
+
+void serial_loopback_fail_transaction(int8_t id, uint32_t count) {
+    failing_transaction  = id;
+    transaction_failures = count;
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    if (index >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+    if (failures > 0) {
+        failures--;
+        return false;
+    }
+    if (index == failing_transaction && transaction_failures > 0) {
+        transaction_failures--;
+        return false;
+    }
+
+    // Points at the entry of whichever half is swapped in
+    split_transaction_desc_t *trans = &split_transaction_table[index];
+    uint8_t                   buffer[UINT8_MAX];
+    uint8_t                   initiator2target_size = trans->initiator2target_buffer_size;
+    uint8_t                   target2initiator_size = trans->target2initiator_buffer_size;
+
+    // Transaction id and handshake, followed by both buffers
+    serial_loopback_stats.transfers++;
+    serial_loopback_stats.bytes += 2 + initiator2target_size + target2initiator_size;
+
+    memcpy(buffer, split_trans_initiator2target_buffer(trans), initiator2target_size);
+    mock_split_swap_halves();
+    if (trans->initiator2target_buffer_size > initiator2target_size) {
+        mock_split_swap_halves();
+        return false;
+    }
+    if (trans->initiator2target_buffer_size < initiator2target_size) {
+        serial_loopback_stats.desyncs++;
+    }
+    memcpy(split_trans_initiator2target_buffer(trans), buffer, trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    uint8_t sent = trans->target2initiator_buffer_size;
+    memcpy(buffer, split_trans_target2initiator_buffer(trans), sent);
+    mock_split_swap_halves();
+    if (sent < target2initiator_size) {
+        return false;
+    }
+    memcpy(split_trans_target2initiator_buffer(trans), buffer, target2initiator_size);
+
+    return true;
+}
@@ -0,0 +1 @@
+TEST_LIST += split_transactions split_transactions_batch split_transactions_batch_size split_transactions_matrix_sequence split_transactions_rpc_fused split_transactions_stats split_transactions_rgb_matrix_frame
@@ -0,0 +1,742 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <deque>
+#include <iostream>
+#include <utility>
+
+extern "C" {
+#include "transactions.h"
+#include "transport.h"
+#include "timer.h"
+#include "mock_split.h"
+#include "transaction_stats.h"
+
+void advance_time(uint32_t ms);
+}
+
+#define ROWS_PER_HAND (MATRIX_ROWS / 2)
+
+// Matches FORCED_SYNC_THROTTLE_MS and SYNC_TIMER_OFFSET in transactions.c
+static const uint32_t forced_sync_ms    = 100;
+static const uint32_t sync_timer_offset = 2;
+
+class SplitTransactions : public ::testing::Test {
+   protected:
+    matrix_row_t master_rows[ROWS_PER_HAND];   // rows of the master half
+    matrix_row_t target_rows[ROWS_PER_HAND];   // rows of the target half
+    matrix_row_t received_rows[ROWS_PER_HAND]; // target rows, as read by the master
+    matrix_row_t mirrored_rows[ROWS_PER_HAND]; // master rows, as mirrored to the target
+
+    void SetUp() override {
+        memset(master_rows, 0, sizeof(master_rows));
+        memset(target_rows, 0, sizeof(target_rows));
+        memset(received_rows, 0, sizeof(received_rows));
+        memset(mirrored_rows, 0, sizeof(mirrored_rows));
+        mock_split_reset();
+        serial_loopback_fail(0);
+        serial_loopback_fail_transaction(-1, 0);
+
+        transport_master_init();
+        mock_split_swap_halves();
+        transport_slave_init();
+        mock_split_swap_halves();
+
+        // Resynchronise whatever earlier tests left behind
+        advance_time(forced_sync_ms);
+        EXPECT_TRUE(scan());
+        memset(&serial_loopback_stats, 0, sizeof(serial_loopback_stats));
+    }
+
+    // Both halves register their RPC callbacks at startup
+    void register_rpc(int8_t transaction_id, slave_callback_t callback) {
+        transaction_register_rpc(transaction_id, callback);
+        mock_split_swap_halves();
+        transaction_register_rpc(transaction_id, callback);
+        mock_split_swap_halves();
+    }
+
+    void run_target(void) {
+        mock_split_swap_halves();
+        transactions_slave(mirrored_rows, target_rows);
+        mock_split_swap_halves();
+    }
+
+    // One pass of the main loop on each half, with the target going first and last
+    bool scan(void) {
+        run_target();
+        bool okay = transactions_master(master_rows, received_rows);
+        run_target();
+        advance_time(1);
+        return okay;
+    }
+
+    void expect_in_sync(void) {
+        EXPECT_EQ(mock_target.layer_state, layer_state);
+        EXPECT_EQ(mock_target.default_layer_state, default_layer_state);
+        EXPECT_EQ(mock_target.real_mods, mock_master.real_mods);
+        EXPECT_EQ(mock_target.weak_mods, mock_master.weak_mods);
+        EXPECT_EQ(mock_target.oneshot_mods, mock_master.oneshot_mods);
+        EXPECT_EQ(mock_target.led_state, mock_master.led_state);
+        EXPECT_EQ(memcmp(mock_target.activity, mock_master.activity, sizeof(mock_master.activity)), 0);
+        EXPECT_EQ(memcmp(received_rows, target_rows, sizeof(target_rows)), 0);
+        EXPECT_EQ(memcmp(mirrored_rows, master_rows, sizeof(master_rows)), 0);
+    }
+};
+
+TEST_F(SplitTransactions, SyncsMasterStateToTarget) {
+    layer_state                    = 0x15;
+    default_layer_state            = 0x2;
+    mock_master.real_mods          = 0x11;
+    mock_master.weak_mods          = 0x22;
+    mock_master.oneshot_mods       = 0x04;
+    mock_master.led_state          = 0x3;
+    mock_master.activity[0]        = 1234;
+    mock_master.activity[2]        = 5678;
+    master_rows[0]                 = 0x21;
+    master_rows[ROWS_PER_HAND - 1] = 0x3F;
+
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+
+    layer_state           = 0x1;
+    mock_master.real_mods = 0;
+    master_rows[0]        = 0;
+
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+
+TEST_F(SplitTransactions, ReadsTargetMatrix) {
+    target_rows[1] = 0x05;
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_rows[1], 0x05);
+
+    target_rows[1] = 0;
+    target_rows[2] = 0x30;
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_rows[1], 0);
+    EXPECT_EQ(received_rows[2], 0x30);
+}
+
+TEST_F(SplitTransactions, ReadsTargetMatrixAfterManyChanges) {
+    target_rows[1] = 0x05;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_rows[1], 0x05);
+
+    // 256 changes between two reads, which would bring an 8 bit change counter back to where it
+    // was, just like a reset of the target could
+    for (int i = 0; i < 256; i++) {
+        target_rows[1] = (i % 2) ? 0x07 : 0x06;
+        run_target();
+    }
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_rows[1], 0x07);
+}
+
+TEST_F(SplitTransactions, CountsRoundTripsPerTargetKeyEvent) {
+    // Short enough to stay clear of the forced resyncs
+    const int events = forced_sync_ms / 2;
+
+    for (int i = 0; i < events; i++) {
+        EXPECT_TRUE(scan());
+    }
+    serial_loopback_stats_t idle = serial_loopback_stats;
+
+    advance_time(forced_sync_ms);
+    EXPECT_TRUE(scan());
+    memset(&serial_loopback_stats, 0, sizeof(serial_loopback_stats));
+
+    // Same number of scans, each with a key changing on the target
+    for (int i = 0; i < events; i++) {
+        target_rows[i % ROWS_PER_HAND] ^= 1 << (i % MATRIX_COLS);
+        EXPECT_TRUE(scan());
+        EXPECT_EQ(memcmp(received_rows, target_rows, sizeof(target_rows)), 0);
+    }
+    serial_loopback_stats_t busy = serial_loopback_stats;
+
+    std::cout << "idle scan: " << (double)idle.transfers / events << " round trips, " << (double)idle.bytes / events << " bytes" << std::endl;
+    std::cout << "key event: " << (double)busy.transfers / events << " round trips, " << (double)busy.bytes / events << " bytes" << std::endl;
+
+#if defined(SPLIT_MATRIX_SEQUENCE) || defined(SPLIT_TRANSACTION_BATCH_EXPECTED)
+    EXPECT_EQ(busy.transfers, idle.transfers);
+#else
+    // The checksum read, then a second round trip for the data
+    EXPECT_EQ(busy.transfers, idle.transfers + events);
+#endif
+}
+
+TEST_F(SplitTransactions, SendsSyncTimerOncePerThrottlePeriod) {
+    // SetUp() sent it one scan ago
+    uint32_t updates = mock_target.sync_timer_updates;
+    uint32_t start   = timer_read32();
+
+    for (uint32_t i = 0; i < forced_sync_ms * 3; i++) {
+        EXPECT_TRUE(scan());
+    }
+
+    EXPECT_EQ(mock_target.sync_timer_updates - updates, 3);
+    EXPECT_EQ(mock_target.sync_timer, start + forced_sync_ms * 3 - 1 + sync_timer_offset);
+}
+
+TEST_F(SplitTransactions, ResendsUnchangedStateAfterThrottlePeriod) {
+    mock_master.real_mods = 0x08;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_target.real_mods, 0x08);
+
+    // Lose the state on the target without the master noticing
+    mock_split_swap_halves();
+    split_shmem->mods.real_mods = 0;
+    mock_split_swap_halves();
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_target.real_mods, 0);
+
+    advance_time(forced_sync_ms);
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_target.real_mods, 0x08);
+}
+
+TEST_F(SplitTransactions, ForwardsTargetEncoderEventsOnce) {
+    uint8_t  index;
+    bool     clockwise;
+    uint32_t drains = mock_target.encoder_drains;
+
+    encoder_queue_event_advanced(&mock_target.encoder_events, 1, true);
+    encoder_queue_event_advanced(&mock_target.encoder_events, 0, false);
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_target.encoder_drains - drains, 1);
+
+    ASSERT_TRUE(encoder_dequeue_event_advanced(&mock_master.encoder_events, &index, &clockwise));
+    EXPECT_EQ(index, 1);
+    EXPECT_TRUE(clockwise);
+    ASSERT_TRUE(encoder_dequeue_event_advanced(&mock_master.encoder_events, &index, &clockwise));
+    EXPECT_EQ(index, 0);
+    EXPECT_FALSE(clockwise);
+
+    EXPECT_TRUE(scan());
+    EXPECT_FALSE(encoder_dequeue_event_advanced(&mock_master.encoder_events, &index, &clockwise));
+    EXPECT_EQ(mock_target.encoder_drains - drains, 1);
+}
+
+static void echo_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *request  = (const uint8_t *)initiator2target_buffer;
+    uint8_t       *response = (uint8_t *)target2initiator_buffer;
+    for (uint8_t i = 0; i < target2initiator_buffer_size && i < initiator2target_buffer_size; i++) {
+        response[i] = request[i] + 1;
+    }
+}
+
+TEST_F(SplitTransactions, RunsRpcBetweenScans) {
+    uint8_t request[3]  = {1, 2, 3};
+    uint8_t response[3] = {0};
+
+    register_rpc(USER_ECHO, echo_callback);
+
+    mock_master.led_state = 0x1;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+    EXPECT_EQ(response[0], 2);
+    EXPECT_EQ(response[1], 3);
+    EXPECT_EQ(response[2], 4);
+
+    mock_master.led_state = 0x2;
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+
+TEST_F(SplitTransactions, CountsRoundTripsPerRpc) {
+    const int calls       = 10;
+    uint8_t   request[4]  = {0};
+    uint8_t   response[4] = {0};
+
+    register_rpc(USER_ECHO, echo_callback);
+
+    // The first call may have to size the frames
+    EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+    memset(&serial_loopback_stats, 0, sizeof(serial_loopback_stats));
+
+    for (int i = 0; i < calls; i++) {
+        request[3] = i;
+        EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+        EXPECT_EQ(response[3], i + 1);
+    }
+
+#ifdef SPLIT_TRANSACTION_RPC_FUSED
+    EXPECT_EQ(serial_loopback_stats.transfers, calls);
+#else
+    // Info, request, execute and response
+    EXPECT_EQ(serial_loopback_stats.transfers, calls * 4);
+#endif
+
+    // Other sizes still get the right data
+    uint8_t short_request[1]  = {7};
+    uint8_t short_response[1] = {0};
+    EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(short_request), short_request, sizeof(short_response), short_response));
+    EXPECT_EQ(short_response[0], 8);
+    EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+    EXPECT_EQ(response[3], calls);
+}
+
+TEST_F(SplitTransactions, RetriesRpcAfterFailedTransfer) {
+    uint8_t request[2]  = {1, 2};
+    uint8_t response[2] = {0};
+
+    register_rpc(USER_ECHO, echo_callback);
+    EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+
+    serial_loopback_fail(1);
+    EXPECT_FALSE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+
+    request[1] = 5;
+    EXPECT_TRUE(transaction_rpc_exec(USER_ECHO, sizeof(request), request, sizeof(response), response));
+    EXPECT_EQ(response[0], 2);
+    EXPECT_EQ(response[1], 6);
+}
+
+
+static uint8_t async_request[RPC_M2S_BUFFER_SIZE];
+static uint8_t async_length;
+static int     async_calls;
+
+static void async_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    memcpy(async_request, initiator2target_buffer, initiator2target_buffer_size);
+    async_length = initiator2target_buffer_size;
+    async_calls++;
+}
+
+#ifdef SPLIT_TRANSACTION_RPC_FUSED
+TEST_F(SplitTransactions, ResendsRpcSizesAfterTargetReset) {
+    uint8_t request[3] = {1, 2, 3};
+
+    register_rpc(USER_ASYNC, async_callback);
+    async_calls = 0;
+    EXPECT_TRUE(transaction_rpc_exec(USER_ASYNC, sizeof(request), request, 0, NULL));
+    EXPECT_EQ(async_calls, 1);
+
+    // The target comes back up without the sizes of the fused transaction
+    mock_split_reset_target();
+    mock_split_swap_halves();
+    transport_slave_init();
+    transaction_register_rpc(USER_ASYNC, async_callback);
+    mock_split_swap_halves();
+
+    // Without response data the transfer completes, the target has to report that it did not run the request
+    request[0] = 7;
+    EXPECT_TRUE(transaction_rpc_exec(USER_ASYNC, sizeof(request), request, 0, NULL));
+    EXPECT_EQ(async_calls, 2);
+    EXPECT_EQ(async_request[0], 7);
+
+    memset(&serial_loopback_stats, 0, sizeof(serial_loopback_stats));
+    EXPECT_TRUE(transaction_rpc_exec(USER_ASYNC, sizeof(request), request, 0, NULL));
+    EXPECT_EQ(async_calls, 3);
+    EXPECT_EQ(serial_loopback_stats.transfers, 1U);
+    EXPECT_EQ(serial_loopback_stats.desyncs, 0U);
+}
+#endif // SPLIT_TRANSACTION_RPC_FUSED
+
+TEST_F(SplitTransactions, SendsAsyncRpcWithNextScan) {
+    uint8_t first[2]  = {1, 2};
+    uint8_t second[3] = {3, 4, 5};
+
+    register_rpc(USER_ASYNC, async_callback);
+    async_calls = 0;
+
+    // Queueing doesn't touch the link, and newer data replaces what is still pending
+    EXPECT_TRUE(transaction_rpc_send_async(USER_ASYNC, sizeof(first), first));
+    EXPECT_TRUE(transaction_rpc_send_async(USER_ASYNC, sizeof(second), second));
+    EXPECT_FALSE(transaction_rpc_send_async(USER_ECHO, sizeof(first), first));
+    EXPECT_EQ(serial_loopback_stats.transfers, 0);
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(async_calls, 1);
+    EXPECT_EQ(async_length, sizeof(second));
+    EXPECT_EQ(memcmp(async_request, second, sizeof(second)), 0);
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(async_calls, 1);
+}
+
+TEST_F(SplitTransactions, KeepsAsyncRpcUntilSent) {
+    uint8_t request[2] = {9, 8};
+
+    register_rpc(USER_ASYNC, async_callback);
+    async_calls = 0;
+
+    EXPECT_TRUE(transaction_rpc_send_async(USER_ASYNC, sizeof(request), request));
+    serial_loopback_fail(UINT32_MAX);
+    EXPECT_FALSE(scan());
+    EXPECT_EQ(async_calls, 0);
+
+    serial_loopback_fail(0);
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(async_calls, 1);
+    EXPECT_EQ(memcmp(async_request, request, sizeof(request)), 0);
+}
+
+TEST_F(SplitTransactions, KeepsAsyncRpcWhileDisconnected) {
+    uint8_t request[1] = {4};
+
+    register_rpc(USER_ASYNC, async_callback);
+    async_calls = 0;
+
+    EXPECT_TRUE(transaction_rpc_send_async(USER_ASYNC, sizeof(request), request));
+    mock_transport_connected = false;
+    // The pending RPC doesn't fail the scan, or the link would never be marked connected again
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(async_calls, 0);
+
+    mock_transport_connected = true;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(async_calls, 1);
+    EXPECT_EQ(async_request[0], 4);
+}
+
+TEST_F(SplitTransactions, ReportsFailedTransfers) {
+    serial_loopback_fail(UINT32_MAX);
+    EXPECT_FALSE(scan());
+
+    serial_loopback_fail(0);
+    mock_master.weak_mods = 0x40;
+    target_rows[0]        = 0x1;
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+
+TEST_F(SplitTransactions, RandomisedStateStaysInSync) {
+    std::deque<std::pair<uint8_t, bool>> pending;
+
+    srand(2024);
+    for (int i = 0; i < 5000; i++) {
+        switch (rand() % 9) {
+            case 0:
+                layer_state = rand();
+                break;
+            case 1:
+                default_layer_state = 1 << (rand() % 4);
+                break;
+            case 2:
+                mock_master.real_mods    = rand();
+                mock_master.oneshot_mods = rand();
+                break;
+            case 3:
+                mock_master.weak_mods = rand();
+                break;
+            case 4:
+                mock_master.led_state = rand();
+                break;
+            case 5:
+                mock_master.activity[rand() % 3] = timer_read32();
+                break;
+            case 6:
+                master_rows[rand() % ROWS_PER_HAND] ^= 1 << (rand() % MATRIX_COLS);
+                break;
+            case 7:
+                target_rows[rand() % ROWS_PER_HAND] ^= 1 << (rand() % MATRIX_COLS);
+                break;
+            case 8: {
+                uint8_t index     = rand() % 2;
+                bool    clockwise = rand() % 2;
+                if (encoder_queue_event_advanced(&mock_target.encoder_events, index, clockwise)) {
+                    pending.push_back(std::make_pair(index, clockwise));
+                }
+                break;
+            }
+        }
+        if (rand() % 8 == 0) {
+            advance_time(rand() % (forced_sync_ms * 2));
+        }
+
+        ASSERT_TRUE(scan());
+        expect_in_sync();
+
+        uint8_t index;
+        bool    clockwise;
+        while (encoder_dequeue_event_advanced(&mock_master.encoder_events, &index, &clockwise)) {
+            ASSERT_FALSE(pending.empty());
+            EXPECT_EQ(index, pending.front().first);
+            EXPECT_EQ(clockwise, pending.front().second);
+            pending.pop_front();
+        }
+        EXPECT_TRUE(pending.empty());
+    }
+}
+
+#ifdef SPLIT_TRANSACTION_BATCH_EXPECTED
+
+TEST_F(SplitTransactions, BatchesIdleScanIntoOneTransfer) {
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(serial_loopback_stats.transfers, 1);
+}
+
+TEST_F(SplitTransactions, BatchesBusyScanIntoTwoTransfers) {
+    layer_state             = 0x3;
+    mock_master.real_mods   = 0x1;
+    mock_master.led_state   = 0x4;
+    mock_master.activity[1] = timer_read32();
+    master_rows[2]          = 0x2;
+    target_rows[3]          = 0x8;
+    encoder_queue_event_advanced(&mock_target.encoder_events, 0, true);
+
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+    EXPECT_EQ(serial_loopback_stats.transfers, 2);
+}
+
+TEST_F(SplitTransactions, BatchFitsBuffers) {
+    EXPECT_LE(split_transaction_table[GET_BATCH].target2initiator_buffer_size, SPLIT_TRANSACTION_BATCH_SIZE);
+    EXPECT_LE(split_transaction_table[PUT_BATCH].initiator2target_buffer_size, sizeof(uint32_t) + SPLIT_TRANSACTION_BATCH_SIZE);
+}
+
+TEST_F(SplitTransactions, BatchSizingStructsMatchTable) {
+    EXPECT_EQ(split_transaction_table[GET_BATCH].target2initiator_buffer_size, sizeof(split_batch_target2initiator_t));
+    EXPECT_EQ(split_transaction_table[PUT_BATCH].initiator2target_buffer_size, sizeof(uint32_t) + sizeof(split_batch_initiator2target_t));
+}
+
+TEST_F(SplitTransactions, ResendsBatchAfterFailedPut) {
+    EXPECT_TRUE(scan());
+
+    mock_master.real_mods = 0x4;
+    mock_master.led_state = 0x2;
+    serial_loopback_fail_transaction(PUT_BATCH, UINT32_MAX);
+    EXPECT_FALSE(scan());
+    EXPECT_EQ(mock_target.real_mods, 0);
+
+    // Well before the forced sync
+    serial_loopback_fail_transaction(PUT_BATCH, 0);
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+
+#endif // SPLIT_TRANSACTION_BATCH_EXPECTED
+
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+
+static split_transaction_stats_t total_transaction_stats(void) {
+    split_transaction_stats_t total = {};
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_transaction_stats_t *stats = split_transaction_stats_get(id);
+        total.attempts += stats->attempts;
+        total.failures += stats->failures;
+        total.checksum_errors += stats->checksum_errors;
+        total.forced += stats->forced;
+        total.bytes += stats->bytes;
+        total.duration += stats->duration;
+        total.max_duration = std::max(total.max_duration, stats->max_duration);
+    }
+    return total;
+}
+
+TEST_F(SplitTransactions, CountsTransfersPerTransaction) {
+    split_transaction_stats_reset();
+    mock_master.real_mods = 0x2;
+    target_rows[0]        = 0x4;
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(scan());
+    }
+
+    split_transaction_stats_t total = total_transaction_stats();
+    EXPECT_EQ(total.attempts, serial_loopback_stats.transfers);
+    EXPECT_EQ(total.failures, 0U);
+    EXPECT_EQ(total.checksum_errors, 0U);
+    EXPECT_EQ(total.forced, 0U);
+    // The loopback also counts the transaction ID and handshake
+    EXPECT_EQ(total.bytes, serial_loopback_stats.bytes - 2 * serial_loopback_stats.transfers);
+    EXPECT_GE(total.duration, total.max_duration);
+
+    // Sent once, when the mods changed
+    EXPECT_EQ(split_transaction_stats_get(PUT_MODS)->attempts, 1U);
+    EXPECT_EQ(split_transaction_stats_get(PUT_MODS)->bytes, sizeof(split_mods_sync_t));
+    EXPECT_EQ(split_transaction_stats_get(NUM_TOTAL_TRANSACTIONS), nullptr);
+}
+
+TEST_F(SplitTransactions, CountsFailedTransfers) {
+    split_transaction_stats_reset();
+    serial_loopback_fail(3);
+    EXPECT_TRUE(scan());
+
+    split_transaction_stats_t total = total_transaction_stats();
+    EXPECT_EQ(total.failures, 3U);
+    EXPECT_EQ(total.attempts, serial_loopback_stats.transfers + 3);
+}
+
+TEST_F(SplitTransactions, CountsForcedResyncs) {
+    split_transaction_stats_reset();
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(total_transaction_stats().forced, 0U);
+
+    advance_time(forced_sync_ms);
+    mock_master.real_mods = 0x8;
+    EXPECT_TRUE(scan());
+    // The mods were sent with the change, the throttle only forces the others
+    EXPECT_EQ(split_transaction_stats_get(PUT_MODS)->forced, 0U);
+    EXPECT_EQ(split_transaction_stats_get(PUT_LAYER_STATE)->forced, 1U);
+    EXPECT_EQ(split_transaction_stats_get(GET_ENCODERS_DATA)->forced, 1U);
+
+    advance_time(forced_sync_ms);
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(split_transaction_stats_get(PUT_MODS)->forced, 1U);
+    EXPECT_EQ(split_transaction_stats_get(PUT_LAYER_STATE)->forced, 2U);
+}
+
+TEST_F(SplitTransactions, CountsChecksumErrors) {
+    split_transaction_stats_reset();
+    target_rows[1] = 0x10;
+    run_target();
+
+    // Corrupt the matrix checksum of the target half
+    mock_split_swap_halves();
+    split_shmem->smatrix.checksum ^= 0xFF;
+    mock_split_swap_halves();
+
+    EXPECT_FALSE(transactions_master(master_rows, received_rows));
+    EXPECT_GT(split_transaction_stats_get(GET_SLAVE_MATRIX_DATA)->checksum_errors, 0U);
+    EXPECT_EQ(total_transaction_stats().failures, 0U);
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(received_rows[1], 0x10);
+}
+
+TEST_F(SplitTransactions, ReportsStatsOverRawHid) {
+    uint8_t data[32] = {SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID, id_split_transaction_stats_get_info};
+
+    split_transaction_stats_reset();
+    mock_master.led_state = 0x1;
+    EXPECT_TRUE(scan());
+
+    EXPECT_TRUE(split_transaction_stats_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(data[2], NUM_TOTAL_TRANSACTIONS);
+
+    memset(data, 0, sizeof(data));
+    data[0] = SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID;
+    data[1] = id_split_transaction_stats_get_stats;
+    data[2] = PUT_LED_STATE;
+    EXPECT_TRUE(split_transaction_stats_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[2], PUT_LED_STATE);
+    EXPECT_EQ(data[6], 1);  // attempts
+    EXPECT_EQ(data[10], 0); // failures
+    EXPECT_EQ(data[22], sizeof(uint8_t));
+
+    data[0] = SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID;
+    data[1] = id_split_transaction_stats_get_stats;
+    data[2] = NUM_TOTAL_TRANSACTIONS;
+    EXPECT_TRUE(split_transaction_stats_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], 0xFF);
+
+    data[0] = SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID;
+    data[1] = id_split_transaction_stats_reset;
+    EXPECT_TRUE(split_transaction_stats_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(split_transaction_stats_get(PUT_LED_STATE)->attempts, 0U);
+
+    data[0] = 0x01;
+    EXPECT_FALSE(split_transaction_stats_raw_hid_receive(data, sizeof(data)));
+}
+
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
+#ifdef SPLIT_RGB_MATRIX_FRAME_ENABLE
+
+// RGB_MATRIX_SPLIT in config.h, the master is the left half
+static const uint8_t rgb_master_leds = 4;
+static const uint8_t rgb_target_leds = 6;
+
+static void set_led(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+    g_rgb_split_frame[index].r = r;
+    g_rgb_split_frame[index].g = g;
+    g_rgb_split_frame[index].b = b;
+}
+
+static bool target_leds_in_sync(void) {
+    return memcmp(&mock_target.rgb_frame[rgb_master_leds], &g_rgb_split_frame[rgb_master_leds], rgb_target_leds * sizeof(RGB)) == 0;
+}
+
+TEST_F(SplitTransactions, MirrorsFrameToTarget) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_led(i, 0x10, 0x20, i < rgb_master_leds ? 0x30 : 0x40);
+    }
+    EXPECT_TRUE(scan());
+
+    EXPECT_TRUE(target_leds_in_sync());
+    EXPECT_GT(mock_target.rgb_frames_received, 0U);
+    // The LEDs of the master half are not sent
+    EXPECT_EQ(mock_target.rgb_frame[0].r, 0);
+}
+
+TEST_F(SplitTransactions, SendsChangedLedsOnly) {
+    EXPECT_TRUE(scan());
+    serial_loopback_stats_t idle = serial_loopback_stats;
+    memset(&serial_loopback_stats, 0, sizeof(serial_loopback_stats));
+
+    set_led(7, 1, 2, 3);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(target_leds_in_sync());
+
+    // The serial transport moves the whole buffer, with the transaction ID and handshake
+    EXPECT_EQ(serial_loopback_stats.transfers, idle.transfers + 1);
+    EXPECT_EQ(serial_loopback_stats.bytes, idle.bytes + 2 + sizeof(split_rgb_matrix_frame_t));
+}
+
+TEST_F(SplitTransactions, SpreadsLargeChangesOverScans) {
+    // Six different colors, three fit into SPLIT_RGB_MATRIX_FRAME_SIZE
+    for (uint8_t i = rgb_master_leds; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_led(i, i, 0, 0);
+    }
+    EXPECT_TRUE(scan());
+    EXPECT_FALSE(target_leds_in_sync());
+
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(target_leds_in_sync());
+}
+
+TEST_F(SplitTransactions, WaitsForCompleteFrame) {
+    mock_master.rgb_frame_busy = true;
+    set_led(5, 9, 9, 9);
+    EXPECT_TRUE(scan());
+    EXPECT_FALSE(target_leds_in_sync());
+
+    mock_master.rgb_frame_busy = false;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(target_leds_in_sync());
+}
+
+TEST_F(SplitTransactions, RetriesFrameAfterFailedTransfer) {
+    set_led(9, 4, 5, 6);
+    serial_loopback_fail(UINT32_MAX);
+    EXPECT_FALSE(scan());
+    EXPECT_FALSE(target_leds_in_sync());
+
+    serial_loopback_fail(0);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(target_leds_in_sync());
+}
+
+TEST_F(SplitTransactions, RefreshesLedsLostByTarget) {
+    for (uint8_t i = rgb_master_leds; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_led(i, 0, i, 0);
+    }
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(target_leds_in_sync());
+
+    // As if the target had been reset
+    memset(mock_target.rgb_frame, 0, sizeof(mock_target.rgb_frame));
+    EXPECT_TRUE(scan());
+    EXPECT_FALSE(target_leds_in_sync());
+
+    // One packet per throttle period, which takes two to cover the half
+    advance_time(forced_sync_ms);
+    EXPECT_TRUE(scan());
+    EXPECT_FALSE(target_leds_in_sync());
+    advance_time(forced_sync_ms);
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(target_leds_in_sync());
+}
+
+#endif // SPLIT_RGB_MATRIX_FRAME_ENABLE
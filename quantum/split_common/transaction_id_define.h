@@ -16,13 +16,21 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 enum serial_transaction_id {
 #ifdef USE_I2C
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_MATRIX_SEQUENCE
+    GET_SLAVE_MATRIX,
+#else // SPLIT_MATRIX_SEQUENCE
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
+#endif // SPLIT_MATRIX_SEQUENCE
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
@@ -97,10 +105,23 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#if defined(SPLIT_TRANSACTION_BATCH)
+    GET_BATCH,
+    PUT_BATCH,
+#endif // defined(SPLIT_TRANSACTION_BATCH)
+
+// Too large to be batched, so it comes after the batch transactions
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+    PUT_RGB_MATRIX_FRAME,
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
     EXECUTE_RPC,
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+    EXECUTE_RPC_FUSED,
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
     GET_RPC_RESP_DATA,
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
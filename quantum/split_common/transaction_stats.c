@@ -0,0 +1,118 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "transaction_stats.h"
+#include "transaction_id_define.h"
+#include "profiling.h"
+#include "print.h"
+
+static split_transaction_stats_t transaction_stats[NUM_TOTAL_TRANSACTIONS];
+
+void split_transaction_stats_record(int8_t id, bool okay, uint16_t bytes, uint32_t ticks) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        return;
+    }
+
+    split_transaction_stats_t *stats = &transaction_stats[id];
+    stats->attempts++;
+    if (okay) {
+        stats->bytes += bytes;
+    } else {
+        stats->failures++;
+    }
+    stats->duration += ticks;
+    if (ticks > stats->max_duration) {
+        stats->max_duration = ticks;
+    }
+}
+
+void split_transaction_stats_forced(int8_t id) {
+    if (id >= 0 && id < NUM_TOTAL_TRANSACTIONS) {
+        transaction_stats[id].forced++;
+    }
+}
+
+void split_transaction_stats_checksum_error(int8_t id) {
+    if (id >= 0 && id < NUM_TOTAL_TRANSACTIONS) {
+        transaction_stats[id].checksum_errors++;
+    }
+}
+
+void split_transaction_stats_reset(void) {
+    memset(transaction_stats, 0, sizeof(transaction_stats));
+}
+
+const split_transaction_stats_t *split_transaction_stats_get(int8_t id) {
+    if (id < 0 || id >= NUM_TOTAL_TRANSACTIONS) {
+        return NULL;
+    }
+    return &transaction_stats[id];
+}
+
+static uint32_t average_duration(const split_transaction_stats_t *stats) {
+    return stats->attempts ? stats->duration / stats->attempts : 0;
+}
+
+void split_transaction_stats_print(void) {
+    uprintf("split: %lu ticks/s\n", (unsigned long)profiling_timestamp_frequency());
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_transaction_stats_t *stats = &transaction_stats[id];
+        if (stats->attempts == 0) {
+            continue;
+        }
+        uprintf("%d: n=%lu fail=%lu crc=%lu forced=%lu bytes=%lu avg=%lu max=%lu\n", id, (unsigned long)stats->attempts, (unsigned long)stats->failures, (unsigned long)stats->checksum_errors, (unsigned long)stats->forced, (unsigned long)stats->bytes, (unsigned long)average_duration(stats), (unsigned long)stats->max_duration);
+    }
+}
+
+static void write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+bool split_transaction_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ command_id, split_transaction_stats_command, transaction_id, ... ]
+    if (length < 32 || data[0] != SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command_id   = &data[0];
+    uint8_t *command_data = &data[2];
+    uint8_t  id           = command_data[0];
+
+    switch (data[1]) {
+        case id_split_transaction_stats_get_info: {
+            // [ transaction_count, frequency(4) ]
+            command_data[0] = NUM_TOTAL_TRANSACTIONS;
+            write_u32(&command_data[1], profiling_timestamp_frequency());
+            break;
+        }
+        case id_split_transaction_stats_get_stats: {
+            // [ transaction_id, attempts(4), failures(4), checksum_errors(4), forced(4), bytes(4), avg(4), max(4) ]
+            if (id >= NUM_TOTAL_TRANSACTIONS) {
+                *command_id = 0xFF;
+                break;
+            }
+            const split_transaction_stats_t *stats = &transaction_stats[id];
+            write_u32(&command_data[1], stats->attempts);
+            write_u32(&command_data[5], stats->failures);
+            write_u32(&command_data[9], stats->checksum_errors);
+            write_u32(&command_data[13], stats->forced);
+            write_u32(&command_data[17], stats->bytes);
+            write_u32(&command_data[21], average_duration(stats));
+            write_u32(&command_data[25], stats->max_duration);
+            break;
+        }
+        case id_split_transaction_stats_reset: {
+            split_transaction_stats_reset();
+            break;
+        }
+        default: {
+            *command_id = 0xFF;
+            break;
+        }
+    }
+    return true;
+}
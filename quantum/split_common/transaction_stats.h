@@ -0,0 +1,102 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \file
+ *
+ * \defgroup split_transaction_stats Split Transaction Statistics
+ *
+ * Counts how often the master runs each split transaction, how often it fails
+ * and how long it takes, using the profiling timestamp. Statistics are kept
+ * per transaction ID in RAM, and can be printed over the console or read back
+ * over raw HID.
+ * \{
+ */
+
+#ifndef SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID
+#    define SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID 0xFB
+#endif
+
+/**
+ * \brief Statistics gathered for a single transaction ID, all durations in timestamp ticks.
+ */
+typedef struct {
+    uint32_t attempts;        // transfers started
+    uint32_t failures;        // transfers that did not complete
+    uint32_t checksum_errors; // completed reads whose data did not match its checksum
+    uint32_t forced;          // sent only because FORCED_SYNC_THROTTLE_MS expired
+    uint32_t bytes;           // payload moved by completed transfers
+    uint32_t max_duration;
+    uint64_t duration; // total of all attempts
+} split_transaction_stats_t;
+
+enum split_transaction_stats_raw_hid_command {
+    id_split_transaction_stats_get_info  = 0x00,
+    id_split_transaction_stats_get_stats = 0x01,
+    id_split_transaction_stats_reset     = 0x02,
+};
+
+/**
+ * \brief Add a transfer to the statistics of a transaction.
+ *
+ * \param id The transaction ID.
+ * \param okay Whether the transfer completed.
+ * \param bytes The payload moved by the transfer.
+ * \param ticks The duration of the transfer in timestamp ticks.
+ */
+void split_transaction_stats_record(int8_t id, bool okay, uint16_t bytes, uint32_t ticks);
+
+/**
+ * \brief Count a transaction sent only because the forced sync throttle expired.
+ */
+void split_transaction_stats_forced(int8_t id);
+
+/**
+ * \brief Count a read that completed, but failed its checksum.
+ */
+void split_transaction_stats_checksum_error(int8_t id);
+
+/**
+ * \brief Clear the statistics of all transactions.
+ */
+void split_transaction_stats_reset(void);
+
+/**
+ * \brief Retrieve the statistics of a transaction, or `NULL` if the ID is out of range.
+ */
+const split_transaction_stats_t *split_transaction_stats_get(int8_t id);
+
+/**
+ * \brief Print the statistics of all transactions that have been attempted over the console.
+ */
+void split_transaction_stats_print(void);
+
+/**
+ * \brief Handle a split transaction statistics raw HID request.
+ *
+ * Requests start with `SPLIT_TRANSACTION_STATS_RAW_HID_COMMAND_ID`, followed by
+ * one of `split_transaction_stats_raw_hid_command`. The response is written
+ * back into `data`.
+ *
+ * \return `true` if the request was handled and `data` should be sent back to the host.
+ */
+bool split_transaction_stats_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+#    define SPLIT_TRANSACTION_STATS_FORCED(id) split_transaction_stats_forced(id)
+#    define SPLIT_TRANSACTION_STATS_CHECKSUM_ERROR(id) split_transaction_stats_checksum_error(id)
+#else
+#    define SPLIT_TRANSACTION_STATS_FORCED(id) \
+        do {                                   \
+        } while (0)
+#    define SPLIT_TRANSACTION_STATS_CHECKSUM_ERROR(id) \
+        do {                                           \
+        } while (0)
+#endif
+
+/** \} */
@@ -28,6 +28,7 @@
 #include "transactions.h"
 #include "transport.h"
 #include "transaction_id_define.h"
+#include "transaction_stats.h"
 #include "split_util.h"
 #include "synchronization_util.h"
 
@@ -84,16 +85,43 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#ifdef SPLIT_TRANSACTION_BATCH
+#    ifdef USE_I2C
+#        error "SPLIT_TRANSACTION_BATCH is only supported by the serial transport"
+#    endif // USE_I2C
+_Static_assert(sizeof(uint32_t) + SPLIT_TRANSACTION_BATCH_SIZE <= UINT8_MAX, "SPLIT_TRANSACTION_BATCH_SIZE too large for a single transaction");
+_Static_assert(sizeof(split_batch_initiator2target_t) <= SPLIT_TRANSACTION_BATCH_SIZE && sizeof(split_batch_target2initiator_t) <= SPLIT_TRANSACTION_BATCH_SIZE, "SPLIT_TRANSACTION_BATCH_SIZE too small for the enabled sync options");
+
+static bool batch_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define split_execute_transaction batch_execute_transaction
+#else // SPLIT_TRANSACTION_BATCH
+#    define split_execute_transaction transport_execute_transaction
+#endif // SPLIT_TRANSACTION_BATCH
+
+#define transport_write(id, data, length) split_execute_transaction(id, data, length, NULL, 0)
+#define transport_read(id, data, length) split_execute_transaction(id, NULL, 0, data, length)
+#define transport_exec(id) split_execute_transaction(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+void slave_rpc_fused_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_TRANSACTION_RPC_FUSED
+#    if defined(__AVR__) && !defined(USE_I2C)
+#        error "SPLIT_TRANSACTION_RPC_FUSED is not supported by the AVR serial driver, which runs the slave callback before receiving the request"
+#    endif // defined(__AVR__) && !defined(USE_I2C)
+// The fused request is the info block directly followed by the request data
+_Static_assert(offsetof(split_shared_memory_t, rpc_m2s_buffer) == offsetof(split_shared_memory_t, rpc_info) + sizeof(rpc_sync_info_t), "RPC info and request data must be contiguous");
+// The fused response is a status byte directly followed by the response data
+_Static_assert(offsetof(split_shared_memory_t, rpc_s2m_buffer) == offsetof(split_shared_memory_t, rpc_fused_status) + 1, "RPC status and response data must be contiguous");
+#    define RPC_FUSED_STATUS_OK 0x5A
+#endif // SPLIT_TRANSACTION_RPC_FUSED
+
 ////////////////////////////////////////////////////
 // Helpers
 
@@ -146,10 +174,17 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
-    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
+    bool    okay    = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+    bool    changed = okay && curr_checksum != crc8(equiv_shmem, length);
+    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || changed)) {
+        if (!changed) {
+            SPLIT_TRANSACTION_STATS_FORCED(trans_id_retrieve);
+        }
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay && curr_checksum != crc8(equiv_shmem, length)) {
+            SPLIT_TRANSACTION_STATS_CHECKSUM_ERROR(trans_id_retrieve);
+            okay = false;
+        }
         if (okay) {
             *last_update = timer_read32();
         }
@@ -162,6 +197,9 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
+        if (!condition) {
+            SPLIT_TRANSACTION_STATS_FORCED(trans_id);
+        }
         okay &= transport_write(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
@@ -175,9 +213,196 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Batched transfers
+
+#ifdef SPLIT_TRANSACTION_BATCH
+
+static uint32_t batch_ids;    // transactions carried by GET_BATCH and PUT_BATCH
+static uint32_t batch_dirty;  // transactions queued for the next PUT_BATCH, kept until it goes through
+static bool     batch_active; // set while transactions_master() runs the handlers
+static uint8_t  batch_initiator2target_offset[NUM_TOTAL_TRANSACTIONS];
+static uint8_t  batch_target2initiator_offset[NUM_TOTAL_TRANSACTIONS];
+
+#    define batch_has(mask, id) (((mask) & (1UL << (id))) != 0)
+
+static bool transaction_is_batchable(int8_t id) {
+#    if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+    if (id == PUT_DETECTED_OS) return true;
+#    endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+    // RPC and keyboard/user transactions are resized at runtime, so they always run on their own
+    return id < GET_BATCH;
+}
+
+void transactions_batch_init(void) {
+    uint16_t initiator2target_size = 0;
+    uint16_t target2initiator_size = 0;
+
+    batch_ids = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!transaction_is_batchable(id)) continue;
+        split_transaction_desc_t *trans   = &split_transaction_table[id];
+        batch_initiator2target_offset[id] = initiator2target_size;
+        batch_target2initiator_offset[id] = target2initiator_size;
+        initiator2target_size += trans->initiator2target_buffer_size;
+        target2initiator_size += trans->target2initiator_buffer_size;
+        batch_ids |= 1UL << id;
+    }
+
+    // The buffers are sized by the structs in transport.h, so this only trips if those miss a transaction
+    if (initiator2target_size > SPLIT_TRANSACTION_BATCH_SIZE || target2initiator_size > SPLIT_TRANSACTION_BATCH_SIZE) {
+        dprintf("SPLIT_TRANSACTION_BATCH_SIZE too small (need %u/%u), not batching\n", initiator2target_size, target2initiator_size);
+        batch_ids = 0;
+        return;
+    }
+
+    // Both halves run the same firmware, so they agree on the shortened frames
+    split_transaction_table[GET_BATCH].target2initiator_buffer_size = target2initiator_size;
+    split_transaction_table[PUT_BATCH].initiator2target_buffer_size = sizeof(split_shmem->batch_request.dirty) + initiator2target_size;
+}
+
+static bool batch_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (!batch_active || !batch_has(batch_ids, id)) {
+        return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    }
+
+    // Stage the request in shared memory like the transport would, and send it with the next PUT_BATCH
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+    if (trans->initiator2target_buffer_size > 0 || trans->slave_callback) {
+        batch_dirty |= 1UL << id;
+    }
+
+    // Replies were already fetched by GET_BATCH at the start of the scan
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+
+static bool batch_get_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!transport_execute_transaction(GET_BATCH, NULL, 0, NULL, 0)) {
+        return false;
+    }
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!batch_has(batch_ids, id)) continue;
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_target2initiator_buffer(trans), &split_shmem->batch_response[batch_target2initiator_offset[id]], trans->target2initiator_buffer_size);
+    }
+    return true;
+}
+
+static bool batch_put_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_shmem->batch_request.dirty = batch_dirty;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!batch_has(batch_dirty, id)) continue;
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(&split_shmem->batch_request.data[batch_initiator2target_offset[id]], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    }
+    return transport_execute_transaction(PUT_BATCH, NULL, 0, NULL, 0);
+}
+
+// Applies a received PUT_BATCH frame, at most once
+static void batch_apply_request(void) {
+    uint32_t dirty                   = split_shmem->batch_request.dirty & batch_ids;
+    split_shmem->batch_request.dirty = 0;
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!batch_has(dirty, id)) continue;
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_initiator2target_buffer(trans), &split_shmem->batch_request.data[batch_initiator2target_offset[id]], trans->initiator2target_buffer_size);
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+}
+
+static void batch_get_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Transports that run the callback before receiving the frame leave it for the next scan
+    batch_apply_request();
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!batch_has(batch_ids, id)) continue;
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(&split_shmem->batch_response[batch_target2initiator_offset[id]], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+    }
+}
+
+static void batch_put_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    batch_apply_request();
+}
+
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+
+static bool transactions_master_batched(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTION_HANDLER_MASTER(batch_get);
+
+    batch_active = true;
+    bool okay    = transactions_master_handlers(master_matrix, slave_matrix);
+    batch_active = false;
+
+    // Anything queued before a failing handler would have been sent already without batching.
+    // The handlers consider queued data as sent, so a failed PUT_BATCH carries it over to the next scan.
+    if (batch_dirty) {
+        TRANSACTION_HANDLER_MASTER(batch_put);
+        batch_dirty = 0;
+    }
+    return okay;
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [GET_BATCH] = trans_target2initiator_initializer_cb(batch_response, batch_get_slave_callback), \
+    [PUT_BATCH] = trans_initiator2target_initializer_cb(batch_request, batch_put_slave_callback),
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCH
+
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCH
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_SEQUENCE
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t       last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+    split_slave_matrix_sync_t temp_smatrix;                         // holding area while we test whether or not checksum is correct
+
+    // Always read the matrix along with its checksum, so a change takes a single transaction
+    bool okay = transport_read(GET_SLAVE_MATRIX, &temp_smatrix, sizeof(temp_smatrix));
+    if (okay && temp_smatrix.checksum != crc8(temp_smatrix.matrix, sizeof(temp_smatrix.matrix))) {
+        SPLIT_TRANSACTION_STATS_CHECKSUM_ERROR(GET_SLAVE_MATRIX);
+        okay = false;
+    }
+    if (okay) {
+        // Checksum matches the received data, save as the last matrix state
+        memcpy(last_matrix, temp_smatrix.matrix, sizeof(last_matrix));
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS [GET_SLAVE_MATRIX] = trans_target2initiator_initializer(smatrix),
+// clang-format on
+
+#else // SPLIT_MATRIX_SEQUENCE
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -199,13 +424,16 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_MATRIX_SEQUENCE
+
+#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -402,25 +630,30 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t   last_update    = 0;
-    bool              mods_need_sync = timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS;
+    bool              mods_need_sync = false;
     split_mods_sync_t new_mods;
     new_mods.real_mods = get_mods();
-    if (!mods_need_sync && new_mods.real_mods != split_shmem->mods.real_mods) {
+    if (new_mods.real_mods != split_shmem->mods.real_mods) {
         mods_need_sync = true;
     }
 
     new_mods.weak_mods = get_weak_mods();
-    if (!mods_need_sync && new_mods.weak_mods != split_shmem->mods.weak_mods) {
+    if (new_mods.weak_mods != split_shmem->mods.weak_mods) {
         mods_need_sync = true;
     }
 
 #    ifndef NO_ACTION_ONESHOT
     new_mods.oneshot_mods = get_oneshot_mods();
-    if (!mods_need_sync && new_mods.oneshot_mods != split_shmem->mods.oneshot_mods) {
+    if (new_mods.oneshot_mods != split_shmem->mods.oneshot_mods) {
         mods_need_sync = true;
     }
 #    endif // NO_ACTION_ONESHOT
 
+    if (!mods_need_sync && timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        SPLIT_TRANSACTION_STATS_FORCED(PUT_MODS);
+        mods_need_sync = true;
+    }
+
     bool okay = true;
     if (mods_need_sync) {
         okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
@@ -598,6 +831,95 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+////////////////////////////////////////////////////
+// RGB Matrix frame
+
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+
+// The LEDs of the slave half in g_rgb_split_frame
+static void rgb_matrix_frame_slave_leds(uint8_t *first, uint8_t *count) {
+    const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
+    if (is_keyboard_left() != is_keyboard_master()) {
+        *first = 0;
+        *count = k_rgb_matrix_split[0];
+    } else {
+        *first = k_rgb_matrix_split[0];
+        *count = k_rgb_matrix_split[1];
+    }
+}
+
+static bool rgb_matrix_frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_refresh   = 0;
+    static uint8_t  cursor         = 0;
+    static uint8_t  refresh_cursor = 0;
+    static uint8_t  sequence       = 0;
+    static RGB      shadow[RGB_MATRIX_LED_COUNT]; // the frame as the slave has it
+
+    // Half rendered frames would show up as tearing on the slave
+    if (!rgb_matrix_split_frame_ready()) {
+        return true;
+    }
+
+    uint8_t first, count;
+    rgb_matrix_frame_slave_leds(&first, &count);
+
+    // Every throttle period, one packet resends LEDs whether they changed or not, in case the slave lost them
+    bool                     refresh = timer_elapsed32(last_refresh) >= FORCED_SYNC_THROTTLE_MS;
+    split_rgb_matrix_frame_t frame;
+    frame.length = rgb_matrix_split_frame_encode(&g_rgb_split_frame[first], &shadow[first], count, refresh, refresh ? &refresh_cursor : &cursor, frame.data, sizeof(frame.data));
+    if (frame.length == 0) {
+        return true;
+    }
+    frame.sequence = ++sequence;
+
+    if (!transport_write(PUT_RGB_MATRIX_FRAME, &frame, offsetof(split_rgb_matrix_frame_t, data) + frame.length)) {
+        return false;
+    }
+    if (refresh) {
+        SPLIT_TRANSACTION_STATS_FORCED(PUT_RGB_MATRIX_FRAME);
+        last_refresh = timer_read32();
+    }
+    rgb_matrix_split_frame_decode(frame.data, frame.length, &shadow[first], count);
+    return true;
+}
+
+static uint8_t rgb_matrix_frame_applied = 0; // sequence of the last packet applied by the slave
+
+static void rgb_matrix_frame_apply(void) {
+    split_rgb_matrix_frame_t *frame = &split_shmem->rgb_matrix_frame;
+    if (frame->sequence == rgb_matrix_frame_applied) {
+        return;
+    }
+    rgb_matrix_frame_applied = frame->sequence;
+
+    uint8_t first, count;
+    rgb_matrix_frame_slave_leds(&first, &count);
+    rgb_matrix_split_frame_decode(frame->data, frame->length < sizeof(frame->data) ? frame->length : sizeof(frame->data), &g_rgb_split_frame[first], count);
+    rgb_matrix_split_frame_received();
+}
+
+static void rgb_matrix_frame_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Transports that run the callback before receiving the packet leave it for here
+    rgb_matrix_frame_apply();
+}
+
+static void rgb_matrix_frame_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Applies the packet before the next one can replace it
+    rgb_matrix_frame_apply();
+}
+
+#    define TRANSACTIONS_RGB_MATRIX_FRAME_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_frame)
+#    define TRANSACTIONS_RGB_MATRIX_FRAME_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(rgb_matrix_frame)
+#    define TRANSACTIONS_RGB_MATRIX_FRAME_REGISTRATIONS [PUT_RGB_MATRIX_FRAME] = trans_initiator2target_initializer_cb(rgb_matrix_frame, rgb_matrix_frame_slave_callback),
+
+#else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+
+#    define TRANSACTIONS_RGB_MATRIX_FRAME_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_FRAME_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_FRAME_REGISTRATIONS
+
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(SPLIT_RGB_MATRIX_FRAME_ENABLE)
+
 ////////////////////////////////////////////////////
 // WPM
 
@@ -908,6 +1230,52 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Asynchronous RPC
+
+#if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+static struct {
+    int8_t  transaction_id; // 0 while nothing is pending, RPC IDs are never 0
+    uint8_t length;
+    uint8_t buffer[RPC_M2S_BUFFER_SIZE];
+} rpc_async;
+
+bool transaction_rpc_send_async(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer) {
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    // Prevent sizing issues
+    if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
+    // Newer data for the pending transaction replaces the data not sent yet
+    if (rpc_async.transaction_id && rpc_async.transaction_id != transaction_id) return false;
+
+    rpc_async.transaction_id = transaction_id;
+    rpc_async.length         = initiator2target_buffer_size;
+    memcpy(rpc_async.buffer, initiator2target_buffer, initiator2target_buffer_size);
+    return true;
+}
+
+static bool rpc_async_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Keep it queued while disconnected, so it doesn't fail the reconnection attempts
+    if (!rpc_async.transaction_id || !is_transport_connected()) {
+        return true;
+    }
+
+    bool okay = transaction_rpc_exec(rpc_async.transaction_id, rpc_async.length, rpc_async.buffer, 0, NULL);
+    if (okay) {
+        rpc_async.transaction_id = 0;
+    }
+    return okay;
+}
+
+#    define TRANSACTIONS_RPC_ASYNC_MASTER() TRANSACTION_HANDLER_MASTER(rpc_async)
+
+#else // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+#    define TRANSACTIONS_RPC_ASYNC_MASTER()
+
+#endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -930,6 +1298,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGBLIGHT_REGISTRATIONS
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_FRAME_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
@@ -938,17 +1307,22 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_BATCH_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
         [PUT_RPC_INFO]  = trans_initiator2target_initializer_cb(rpc_info, slave_rpc_info_callback),
     [PUT_RPC_REQ_DATA]  = trans_initiator2target_initializer(rpc_m2s_buffer),
     [EXECUTE_RPC]       = trans_initiator2target_initializer_cb(rpc_info.payload.transaction_id, slave_rpc_exec_callback),
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+    // Sized by PUT_RPC_INFO, starts out as an RPC without request or response data
+    [EXECUTE_RPC_FUSED] = {sizeof(rpc_sync_info_t), offsetof(split_shared_memory_t, rpc_info), 1, offsetof(split_shared_memory_t, rpc_fused_status), slave_rpc_fused_callback},
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
     [GET_RPC_RESP_DATA] = trans_target2initiator_initializer(rpc_s2m_buffer),
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -960,6 +1334,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
     TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_FRAME_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
@@ -968,9 +1343,19 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_ASYNC_MASTER();
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSACTION_BATCH
+    if (batch_ids) {
+        return transactions_master_batched(master_matrix, slave_matrix);
+    }
+#endif // SPLIT_TRANSACTION_BATCH
+    return transactions_master_handlers(master_matrix, slave_matrix);
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -983,6 +1368,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGBLIGHT_SLAVE();
     TRANSACTIONS_LED_MATRIX_SLAVE();
     TRANSACTIONS_RGB_MATRIX_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_FRAME_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
@@ -1005,6 +1391,55 @@ void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback)
     split_transaction_table[transaction_id].target2initiator_offset = offsetof(split_shared_memory_t, rpc_s2m_buffer);
 }
 
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+
+static bool rpc_fused_sized = false;
+
+static void rpc_fused_resize(uint8_t m2s_length, uint8_t s2m_length) {
+    split_transaction_table[EXECUTE_RPC_FUSED].initiator2target_buffer_size = sizeof(rpc_sync_info_t) + m2s_length;
+    split_transaction_table[EXECUTE_RPC_FUSED].target2initiator_buffer_size = 1 + s2m_length;
+}
+
+static bool transaction_rpc_exec_fused(const rpc_sync_info_t *info, const void *initiator2target_buffer, void *target2initiator_buffer) {
+    split_transaction_desc_t *trans      = &split_transaction_table[EXECUTE_RPC_FUSED];
+    uint8_t                   m2s_length = info->payload.m2s_length;
+    uint8_t                   s2m_length = info->payload.s2m_length;
+
+    uint8_t frame[sizeof(rpc_sync_info_t) + RPC_M2S_BUFFER_SIZE];
+    uint8_t response[1 + RPC_S2M_BUFFER_SIZE];
+    memcpy(frame, info, sizeof(rpc_sync_info_t));
+    memcpy(&frame[sizeof(rpc_sync_info_t)], initiator2target_buffer, m2s_length);
+
+    // A second attempt, if the slave reports that it lost the sizes, e.g. because it was reset
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        // The slave needs to know the frame sizes up front, so they are only sent when they change
+        if (!rpc_fused_sized || trans->initiator2target_buffer_size != sizeof(rpc_sync_info_t) + m2s_length || trans->target2initiator_buffer_size != 1 + s2m_length) {
+            if (!transport_write(PUT_RPC_INFO, info, sizeof(rpc_sync_info_t))) {
+                return false;
+            }
+            rpc_fused_resize(m2s_length, s2m_length);
+            rpc_fused_sized = true;
+        }
+
+        // Send the info block, request data and execute the RPC callback, and retrieve the status and response in the same transaction
+        response[0] = 0;
+        if (!transport_execute_transaction(EXECUTE_RPC_FUSED, frame, sizeof(rpc_sync_info_t) + m2s_length, response, 1 + s2m_length)) {
+            rpc_fused_sized = false;
+            return false;
+        }
+        if (response[0] == RPC_FUSED_STATUS_OK) {
+            if (s2m_length > 0) {
+                memcpy(target2initiator_buffer, &response[1], s2m_length);
+            }
+            return true;
+        }
+        rpc_fused_sized = false;
+    }
+    return false;
+}
+
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
+
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
     // Prevent transaction attempts while transport is disconnected
     if (!is_transport_connected()) {
@@ -1020,6 +1455,9 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     rpc_sync_info_t info = {.payload = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = target2initiator_buffer_size}};
     info.checksum        = crc8(&info.payload, sizeof(info.payload));
 
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+    return transaction_rpc_exec_fused(&info, initiator2target_buffer, target2initiator_buffer);
+#    else // SPLIT_TRANSACTION_RPC_FUSED
     // Make sure the local side knows that we're not sending the full block of data
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = initiator2target_buffer_size;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = target2initiator_buffer_size;
@@ -1042,6 +1480,7 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
         return false;
     }
     return true;
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
 }
 
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
@@ -1051,6 +1490,9 @@ void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *i
 
     split_transaction_table[PUT_RPC_REQ_DATA].initiator2target_buffer_size  = split_shmem->rpc_info.payload.m2s_length;
     split_transaction_table[GET_RPC_RESP_DATA].target2initiator_buffer_size = split_shmem->rpc_info.payload.s2m_length;
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+    rpc_fused_resize(split_shmem->rpc_info.payload.m2s_length, split_shmem->rpc_info.payload.s2m_length);
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
 }
 
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
@@ -1070,4 +1512,20 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 }
 
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+
+void slave_rpc_fused_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // The frame was sized by the last PUT_RPC_INFO, so only run the request if its info block agrees with it,
+    // and tell the master otherwise so that it sends the sizes again
+    split_transaction_desc_t *trans = &split_transaction_table[EXECUTE_RPC_FUSED];
+    if (trans->initiator2target_buffer_size != sizeof(rpc_sync_info_t) + split_shmem->rpc_info.payload.m2s_length || trans->target2initiator_buffer_size != 1 + split_shmem->rpc_info.payload.s2m_length) {
+        split_shmem->rpc_fused_status = 0;
+        return;
+    }
+    split_shmem->rpc_fused_status = RPC_FUSED_STATUS_OK;
+    slave_rpc_exec_callback(initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+}
+
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
+
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
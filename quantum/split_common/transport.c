@@ -22,6 +22,11 @@
 #include "transaction_id_define.h"
 #include "atomic_util.h"
 
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+#    include "transaction_stats.h"
+#    include "profiling.h"
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+
 #ifdef USE_I2C
 
 #    ifndef SLAVE_I2C_TIMEOUT
@@ -59,7 +64,7 @@ i2c_status_t transport_trigger_callback(int8_t id) {
     return i2c_write_register(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT);
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_transfer(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     i2c_status_t              status;
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
@@ -86,6 +91,15 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSACTION_STATS_ENABLE
+// Only the requested part of each buffer goes over the bus
+static uint16_t transport_transfer_size(int8_t id, uint16_t initiator2target_length, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    uint16_t                  size  = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+    return size + (trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length);
+}
+#    endif // SPLIT_TRANSACTION_STATS_ENABLE
+
 #else // USE_I2C
 
 #    include "serial.h"
@@ -94,13 +108,19 @@ static split_shared_memory_t shared_memory;
 split_shared_memory_t *const split_shmem = &shared_memory;
 
 void transport_master_init(void) {
+#    ifdef SPLIT_TRANSACTION_BATCH
+    transactions_batch_init();
+#    endif // SPLIT_TRANSACTION_BATCH
     soft_serial_initiator_init();
 }
 void transport_slave_init(void) {
+#    ifdef SPLIT_TRANSACTION_BATCH
+    transactions_batch_init();
+#    endif // SPLIT_TRANSACTION_BATCH
     soft_serial_target_init();
 }
 
-bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+static bool transport_transfer(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
     split_transaction_desc_t *trans = &split_transaction_table[id];
     if (initiator2target_length > 0) {
         size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
@@ -119,8 +139,27 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSACTION_STATS_ENABLE
+// The serial protocol always moves both buffers in full
+static uint16_t transport_transfer_size(int8_t id, uint16_t initiator2target_length, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    return trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+}
+#    endif // SPLIT_TRANSACTION_STATS_ENABLE
+
 #endif // USE_I2C
 
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    uint32_t start = profiling_timestamp();
+    bool     okay  = transport_transfer(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    split_transaction_stats_record(id, okay, transport_transfer_size(id, initiator2target_length, target2initiator_length), profiling_timestamp() - start);
+    return okay;
+#else
+    return transport_transfer(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+#endif // SPLIT_TRANSACTION_STATS_ENABLE
+}
+
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     return transactions_master(master_matrix, slave_matrix);
 }
@@ -20,6 +20,7 @@
 #include <stdbool.h>
 
 #include "progmem.h"
+#include "util.h"
 #include "action_layer.h"
 #include "matrix.h"
 
@@ -93,6 +94,20 @@ typedef struct _rgb_matrix_sync_t {
     rgb_config_t rgb_matrix;
     bool         rgb_suspend_state;
 } rgb_matrix_sync_t;
+
+#    ifdef SPLIT_RGB_MATRIX_FRAME_ENABLE
+#        include "rgb_matrix_split_frame.h"
+
+#        ifndef SPLIT_RGB_MATRIX_FRAME_SIZE
+#            define SPLIT_RGB_MATRIX_FRAME_SIZE 32
+#        endif // SPLIT_RGB_MATRIX_FRAME_SIZE
+
+typedef struct _split_rgb_matrix_frame_t {
+    uint8_t sequence; // changes with every packet, so the slave applies each one once
+    uint8_t length;
+    uint8_t data[SPLIT_RGB_MATRIX_FRAME_SIZE];
+} split_rgb_matrix_frame_t;
+#    endif // SPLIT_RGB_MATRIX_FRAME_ENABLE
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #ifdef SPLIT_MODS_ENABLE
@@ -146,6 +161,83 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#if defined(SPLIT_TRANSACTION_BATCH)
+// Everything the batched transactions send in each direction, only used to size the batch buffers
+typedef struct PACKED _split_batch_initiator2target_t {
+#    ifdef SPLIT_TRANSPORT_MIRROR
+    split_master_matrix_sync_t mmatrix;
+#    endif // SPLIT_TRANSPORT_MIRROR
+#    ifndef DISABLE_SYNC_TIMER
+    uint32_t sync_timer;
+#    endif // DISABLE_SYNC_TIMER
+#    if !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+    split_layers_sync_t layers;
+#    endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
+#    ifdef SPLIT_LED_STATE_ENABLE
+    uint8_t led_state;
+#    endif // SPLIT_LED_STATE_ENABLE
+#    ifdef SPLIT_MODS_ENABLE
+    split_mods_sync_t mods;
+#    endif // SPLIT_MODS_ENABLE
+#    ifdef BACKLIGHT_ENABLE
+    uint8_t backlight_level;
+#    endif // BACKLIGHT_ENABLE
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    rgblight_syncinfo_t rgblight_sync;
+#    endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    led_matrix_sync_t led_matrix_sync;
+#    endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    rgb_matrix_sync_t rgb_matrix_sync;
+#    endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#    if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+    uint8_t current_wpm;
+#    endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+#    if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+    uint8_t current_oled_state;
+#    endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+#    if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+    uint8_t current_st7565_state;
+#    endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    uint16_t pointing_cpi;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+    bool watchdog_pinged;
+#    endif // defined(SPLIT_WATCHDOG_ENABLE)
+#    if defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
+    split_slave_haptic_sync_t haptic_sync;
+#    endif // defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
+#    if defined(SPLIT_ACTIVITY_ENABLE)
+    split_slave_activity_sync_t activity_sync;
+#    endif // defined(SPLIT_ACTIVITY_ENABLE)
+#    if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+    os_variant_t detected_os;
+#    endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+} split_batch_initiator2target_t;
+
+typedef struct PACKED _split_batch_target2initiator_t {
+    split_slave_matrix_sync_t smatrix;
+#    ifdef ENCODER_ENABLE
+    split_slave_encoder_sync_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    uint8_t        pointing_checksum;
+    report_mouse_t pointing_report;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_target2initiator_t;
+
+#    ifndef SPLIT_TRANSACTION_BATCH_SIZE
+#        define SPLIT_TRANSACTION_BATCH_SIZE (sizeof(split_batch_initiator2target_t) > sizeof(split_batch_target2initiator_t) ? sizeof(split_batch_initiator2target_t) : sizeof(split_batch_target2initiator_t))
+#    endif // SPLIT_TRANSACTION_BATCH_SIZE
+
+typedef struct _split_batch_request_t {
+    uint32_t dirty;
+    uint8_t  data[SPLIT_TRANSACTION_BATCH_SIZE];
+} split_batch_request_t;
+#endif // defined(SPLIT_TRANSACTION_BATCH)
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -191,6 +283,9 @@ typedef struct _split_shared_memory_t {
 
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     rgb_matrix_sync_t rgb_matrix_sync;
+#    ifdef SPLIT_RGB_MATRIX_FRAME_ENABLE
+    split_rgb_matrix_frame_t rgb_matrix_frame;
+#    endif // SPLIT_RGB_MATRIX_FRAME_ENABLE
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -221,10 +316,18 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#if defined(SPLIT_TRANSACTION_BATCH)
+    split_batch_request_t batch_request;
+    uint8_t               batch_response[SPLIT_TRANSACTION_BATCH_SIZE];
+#endif // defined(SPLIT_TRANSACTION_BATCH)
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
-    uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+#    ifdef SPLIT_TRANSACTION_RPC_FUSED
+    uint8_t rpc_fused_status;
+#    endif // SPLIT_TRANSACTION_RPC_FUSED
+    uint8_t rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
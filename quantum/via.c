@@ -57,6 +57,18 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(PROFILING_ENABLE)
+#    include "profiling.h"
+#endif
+
+#if defined(LATENCY_TRACKER_ENABLE)
+#    include "latency_tracker.h"
+#endif
+
+#if defined(SPLIT_TRANSACTION_STATS_ENABLE)
+#    include "transaction_stats.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -280,6 +292,25 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
 
+#ifdef PROFILING_ENABLE
+    if (profiling_raw_hid_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#ifdef LATENCY_TRACKER_ENABLE
+    if (latency_tracker_raw_hid_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+#ifdef SPLIT_TRANSACTION_STATS_ENABLE
+    if (split_transaction_stats_raw_hid_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+
     // If via_command_kb() returns true, the command was fully
     // handled, including calling raw_hid_send()
     if (via_command_kb(data, length)) {
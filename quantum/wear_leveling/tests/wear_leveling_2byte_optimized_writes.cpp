@@ -293,3 +293,58 @@ TEST_F(WearLeveling2ByteOptimizedWrites, PlaybackReadbackWord01_Success) {
     wear_leveling_read(0x02, &tmp, sizeof(tmp));
     EXPECT_EQ(tmp, 1) << "Failed to read back the seeded data";
 }
+
+/**
+ * This test measures the backing store writes needed to upload a full dynamic keymap in VIA-sized chunks, comparing byte-by-byte updates with block
+ * updates, and verifies that re-uploading a keymap with a single changed keycode only logs the changed bytes.
+ */
+TEST_F(WearLeveling2ByteOptimizedWrites, KeymapUploadBackingStoreWriteCounts) {
+    auto& inst = MockBackingStore::Instance();
+
+    // 4 layers of a 6x16 matrix, uploaded in 28-byte chunks, starting past the optimised single-byte addresses
+    constexpr uint32_t keymap_address = 1000;
+    constexpr size_t   keymap_size    = 4 * 6 * 16 * 2;
+    constexpr size_t   chunk_size     = 28;
+
+    std::vector<std::uint8_t> keymap(keymap_size);
+    for (size_t i = 0; i < keymap_size; i += 2) {
+        keymap[i]     = 0x70;
+        keymap[i + 1] = (uint8_t)(0x04 + (i / 2) % 0xF0);
+    }
+
+    // Byte-by-byte updates, one log entry per byte
+    std::fill(verify_data.begin(), verify_data.end(), 0);
+    for (size_t i = 0; i < keymap_size; ++i) {
+        EXPECT_EQ(test_write(keymap_address + i, &keymap[i], 1), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    std::uint64_t bytewise_writes = inst.total_write_count();
+    EXPECT_EQ(bytewise_writes, keymap_size * 2) << "Each single byte update should use a two-write multibyte entry";
+
+    // Block updates, one log entry per LOG_ENTRY_MULTIBYTE_MAX_BYTES
+    inst.reset_instance();
+    wear_leveling_init();
+    std::fill(verify_data.begin(), verify_data.end(), 0);
+    for (size_t offset = 0; offset < keymap_size; offset += chunk_size) {
+        size_t length = std::min(chunk_size, keymap_size - offset);
+        EXPECT_EQ(test_write(keymap_address + offset, &keymap[offset], length), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    std::uint64_t block_writes = inst.total_write_count();
+    EXPECT_LT(block_writes, bytewise_writes / 2) << "Block updates should need less than half the backing store writes";
+    RecordProperty("bytewise_writes", std::to_string(bytewise_writes));
+    RecordProperty("block_writes", std::to_string(block_writes));
+
+    // Re-upload with a single keycode changed, only that keycode should be logged
+    std::uint64_t writes_before = inst.total_write_count();
+    keymap[301]                 = 0x2A;
+    for (size_t offset = 0; offset < keymap_size; offset += chunk_size) {
+        size_t length = std::min(chunk_size, keymap_size - offset);
+        EXPECT_EQ(test_write(keymap_address + offset, &keymap[offset], length), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    EXPECT_EQ(inst.total_write_count() - writes_before, 2) << "Only the changed byte should have been written";
+
+    // Verify the data survives a reload
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), WEAR_LEVELING_LOGICAL_SIZE), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_TRUE(memcmp(readback.data(), verify_data.data(), WEAR_LEVELING_LOGICAL_SIZE) == 0) << "Readback did not match";
+}
@@ -671,6 +671,57 @@ wear_leveling_status_t wear_leveling_erase(void) {
     return ret ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
 }
 
+/**
+ * Writes the parts of the supplied data which differ from the cache to the write log, so that updating a large block only logs the bytes that changed.
+ *
+ * Runs of changed bytes separated by fewer than LOG_ENTRY_MULTIBYTE_COALESCE_GAP unchanged bytes are written as a single run, as that is cheaper than starting a new log entry.
+ */
+static wear_leveling_status_t wear_leveling_write_changes(uint32_t address, const void *value, size_t length) {
+    const uint8_t *        p            = value;
+    const uint8_t *        cache        = &wear_leveling.cache[address];
+    bool                   consolidated = false;
+    size_t                 start        = 0;
+    wear_leveling_status_t status       = WEAR_LEVELING_SUCCESS;
+
+    // Writes fitting in a single log entry gain nothing from being split
+    if (length <= LOG_ENTRY_MULTIBYTE_MAX_BYTES) {
+        memcpy(&wear_leveling.cache[address], value, length);
+        return wear_leveling_write_raw(address, value, length);
+    }
+
+    while (start < length) {
+        // Find the start of the next changed run
+        if (p[start] == cache[start]) {
+            ++start;
+            continue;
+        }
+
+        // Find the end of the run, extending it over short gaps of unchanged bytes
+        size_t end = start + 1;
+        for (size_t i = end; i < length && i - end < LOG_ENTRY_MULTIBYTE_COALESCE_GAP; ++i) {
+            if (p[i] != cache[i]) {
+                end = i + 1;
+            }
+        }
+
+        // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
+        memcpy(&wear_leveling.cache[address + start], &p[start], end - start);
+        status = wear_leveling_write_raw(address + (uint32_t)start, &p[start], end - start);
+        if (status == WEAR_LEVELING_FAILED) {
+            // Keep the cache consistent with what the caller asked for, as if the whole write had been applied up front
+            memcpy(&wear_leveling.cache[address], value, length);
+            return status;
+        }
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            // The cache was written to the consolidated area, any remaining runs go into the fresh write log
+            consolidated = true;
+        }
+        start = end;
+    }
+
+    return consolidated ? WEAR_LEVELING_CONSOLIDATED : status;
+}
+
 /**
  * Writes logical data into the backing store. Skips writes if there are no changes to values.
  */
@@ -688,18 +739,16 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
-    // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
-    memcpy(&wear_leveling.cache[address], value, length);
-
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
+        memcpy(&wear_leveling.cache[address], value, length);
         wear_leveling_lock();
         return WEAR_LEVELING_FAILED;
     }
 
     // Perform the actual write
-    wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+    wear_leveling_status_t status = wear_leveling_write_changes(address, value, length);
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
         case WEAR_LEVELING_FAILED:
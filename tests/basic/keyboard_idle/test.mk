@@ -0,0 +1,4 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SRC += ../test_keypress.cpp ../test_one_shot_keys.cpp ../test_tapping.cpp
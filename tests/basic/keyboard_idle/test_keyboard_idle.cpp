@@ -0,0 +1,102 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class KeyboardIdle : public TestFixture {};
+
+TEST_F(KeyboardIdle, NothingScheduledWithoutKeys) {
+    TestDriver driver;
+    auto       regular_key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({regular_key});
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, RegularKeyDoesNotScheduleWork) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({regular_key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, HeldModTapReportsRemainingTappingTerm) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 7, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    EXPECT_EQ(keyboard_idle_time(), TAPPING_TERM - 1);
+
+    idle_for(TAPPING_TERM / 2);
+    EXPECT_EQ(keyboard_idle_time(), TAPPING_TERM - 1 - TAPPING_TERM / 2);
+
+    idle_for(TAPPING_TERM - 1 - TAPPING_TERM / 2);
+    EXPECT_EQ(keyboard_idle_time(), 0U);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdle, TappedModTapWaitsForQuickTap) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 7, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    // The tapping term restarts with the release
+    EXPECT_EQ(keyboard_idle_time(), TAPPING_TERM - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(TAPPING_TERM);
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,60 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+// Mirror the columns
+extern "C" {
+const keypos_t PROGMEM hand_swap_config[MATRIX_ROWS][MATRIX_COLS] = {
+    {{9, 0}, {8, 0}, {7, 0}, {6, 0}, {5, 0}, {4, 0}, {3, 0}, {2, 0}, {1, 0}, {0, 0}},
+    {{9, 1}, {8, 1}, {7, 1}, {6, 1}, {5, 1}, {4, 1}, {3, 1}, {2, 1}, {1, 1}, {0, 1}},
+    {{9, 2}, {8, 2}, {7, 2}, {6, 2}, {5, 2}, {4, 2}, {3, 2}, {2, 2}, {1, 2}, {0, 2}},
+    {{9, 3}, {8, 3}, {7, 3}, {6, 3}, {5, 3}, {4, 3}, {3, 3}, {2, 3}, {1, 3}, {0, 3}},
+};
+}
+
+class KeyboardIdleSwapHands : public TestFixture {};
+
+TEST_F(KeyboardIdleSwapHands, OneShotSwapHandsReportsRemainingTimeout) {
+    TestDriver driver;
+    InSequence s;
+    auto       swap_key = KeymapKey(0, 0, 0, SH_OS);
+
+    set_keymap({swap_key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(swap_key);
+    // The timeout runs from the press, two scans ago
+    EXPECT_EQ(keyboard_idle_time(), ONESHOT_TIMEOUT - 2);
+
+    idle_for(ONESHOT_TIMEOUT / 2);
+    EXPECT_EQ(keyboard_idle_time(), ONESHOT_TIMEOUT - 2 - ONESHOT_TIMEOUT / 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyboardIdleSwapHands, ExpiredOneShotSwapHandsDoesNotSwapNextKey) {
+    TestDriver driver;
+    InSequence s;
+    auto       swap_key    = KeymapKey(0, 0, 0, SH_OS);
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto       swapped_key = KeymapKey(0, 8, 0, KC_B);
+
+    set_keymap({swap_key, regular_key, swapped_key});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(swap_key);
+    idle_for(ONESHOT_TIMEOUT);
+    EXPECT_EQ(keyboard_idle_time(), IDLE_TIME_FOREVER);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
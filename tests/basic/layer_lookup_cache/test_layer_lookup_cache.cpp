@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {};
+
+TEST_F(LayerLookupCache, ResolvesThroughTransparentKeys) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(1, 1, 0, KC_C), KeymapKey(2, 0, 0, KC_TRNS), KeymapKey(2, 1, 0, KC_TRNS)});
+
+    layer_state_set(0b110);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+    /* Cached results are returned on repeated lookups. */
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, LayerStateChangeInvalidates) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* Direct writes to the layer state, e.g. from split sync, are picked up too. */
+    layer_state = 0b10;
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    layer_state = 0;
+
+    default_layer_set(0b10);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    default_layer_set(0b01);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, KeymapChangeRequiresClear) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* set_keymap() clears the cache, as dynamic keymap updates do. */
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerLookupCache, KeypressUsesResolvedLayer) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_layer(0, 1, 0, MO(1));
+    set_keymap({key_a, key_layer, KeymapKey(1, 0, 0, KC_B), KeymapKey(1, 1, 0, KC_TRNS)});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_layer.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_layer.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,130 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_benchmark.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+class ScanLoop : public BenchmarkFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+};
+
+TEST_F(ScanLoop, PlainTyping) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    auto result = benchmark("typing", 1000, [&]() {
+        tap(key_a);
+        tap(key_b);
+        tap(key_c);
+    });
+    EXPECT_EQ(result.events, 6000U);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanLoop, ModTapTapped) {
+    TestDriver driver;
+    KeymapKey  mod_tap_key(0, 0, 0, SFT_T(KC_A));
+    set_keymap({mod_tap_key});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark("mod_tap_tapped", 1000, [&]() {
+        tap(mod_tap_key);
+        scan(TAPPING_TERM);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanLoop, ModTapHeldWithInterrupt) {
+    TestDriver driver;
+    KeymapKey  mod_tap_key(0, 0, 0, SFT_T(KC_A));
+    KeymapKey  regular_key(0, 1, 0, KC_B);
+    set_keymap({mod_tap_key, regular_key});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark("mod_tap_held", 1000, [&]() {
+        press(mod_tap_key);
+        scan(TAPPING_TERM + 1);
+        tap(regular_key);
+        release(mod_tap_key);
+        scan(1);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanLoop, Combo) {
+    TestDriver driver;
+    KeymapKey  key_j(0, 0, 0, KC_J);
+    KeymapKey  key_k(0, 1, 0, KC_K);
+    KeymapKey  key_d(0, 2, 0, KC_D);
+    KeymapKey  key_f(0, 3, 0, KC_F);
+    set_keymap({key_j, key_k, key_d, key_f});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark("combo", 1000, [&]() {
+        chord({key_j, key_k});
+        tap(key_d);
+        scan(COMBO_TERM);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanLoop, TapDance) {
+    TestDriver driver;
+    KeymapKey  key_td(0, 0, 0, TD(0));
+    set_keymap({key_td});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark("tap_dance_double", 1000, [&]() {
+        tap(key_td);
+        tap(key_td);
+        scan(TAPPING_TERM);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanLoop, KeyOverride) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_shift, key_bspc});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark("key_override", 1000, [&]() {
+        press(key_shift);
+        scan(1);
+        tap(key_bspc);
+        release(key_shift);
+        scan(1);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanLoop, Autocorrect) {
+    TestDriver driver;
+    KeymapKey  key_f(0, 0, 0, KC_F);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    KeymapKey  key_l(0, 2, 0, KC_L);
+    KeymapKey  key_e(0, 3, 0, KC_E);
+    KeymapKey  key_s(0, 4, 0, KC_S);
+    KeymapKey  key_space(0, 5, 0, KC_SPACE);
+    set_keymap({key_f, key_a, key_l, key_e, key_s, key_space});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark("autocorrect", 1000, [&]() {
+        for (const KeymapKey& key : {key_f, key_a, key_l, key_e, key_s, key_space}) {
+            tap(key);
+        }
+    });
+    VERIFY_AND_CLEAR(driver);
+}
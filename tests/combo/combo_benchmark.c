@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "keymap_introspection.h"
+#include "combo_benchmark.h"
+
+/* Extra combos appended after the keymap's own combos. The benchmark fills
+ * the key arrays and chooses how many of them are visible to process_combo(). */
+uint16_t combo_benchmark_keys[COMBO_BENCHMARK_MAX][3];
+combo_t  combo_benchmark_combos[COMBO_BENCHMARK_MAX];
+uint16_t combo_benchmark_count = 0;
+
+uint16_t combo_count(void) {
+    return combo_count_raw() + combo_benchmark_count;
+}
+
+combo_t *combo_get(uint16_t combo_idx) {
+    if (combo_idx < combo_count_raw()) {
+        return combo_get_raw(combo_idx);
+    }
+    return &combo_benchmark_combos[combo_idx - combo_count_raw()];
+}
@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "process_combo.h"
+
+#define COMBO_BENCHMARK_MAX 256
+
+extern uint16_t combo_benchmark_keys[COMBO_BENCHMARK_MAX][3];
+extern combo_t  combo_benchmark_combos[COMBO_BENCHMARK_MAX];
+extern uint16_t combo_benchmark_count;
@@ -4,3 +4,5 @@
 COMBO_ENABLE = yes
 
 INTROSPECTION_KEYMAP_C = test_combos.c
+
+SRC += combo_benchmark.c
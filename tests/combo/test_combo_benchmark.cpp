@@ -0,0 +1,76 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "combo_benchmark.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class ComboBenchmark : public BenchmarkFixture, public testing::WithParamInterface<uint16_t> {
+   public:
+    void SetUp() override {
+        uint16_t count = GetParam();
+        for (uint16_t i = 0; i < count; i++) {
+            combo_benchmark_keys[i][0] = KC_A + (i % 16);
+            combo_benchmark_keys[i][1] = KC_Q + (i / 16);
+            combo_benchmark_keys[i][2] = COMBO_END;
+
+            combo_benchmark_combos[i]         = combo_t{};
+            combo_benchmark_combos[i].keys    = combo_benchmark_keys[i];
+            combo_benchmark_combos[i].keycode = KC_F24;
+        }
+        combo_benchmark_count = count;
+#ifdef COMBO_KEYCODE_INDEX
+        // A full index would silently benchmark the linear walk instead
+        ASSERT_TRUE(combo_rebuild_index());
+#endif
+    }
+
+    void TearDown() override {
+        combo_benchmark_count = 0;
+#ifdef COMBO_KEYCODE_INDEX
+        combo_rebuild_index();
+#endif
+    }
+
+    std::string name(const char* workload) {
+        return std::string(workload) + "_" + std::to_string(GetParam()) + "_combos";
+    }
+};
+
+TEST_P(ComboBenchmark, TypingNonComboKeys) {
+    TestDriver driver;
+    KeymapKey  key_f1(0, 0, 0, KC_F1);
+    KeymapKey  key_f2(0, 1, 0, KC_F2);
+    set_keymap({key_f1, key_f2});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark(name("typing"), 1000, [&]() {
+        tap(key_f1);
+        tap(key_f2);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(ComboBenchmark, TappingCombo) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_q(0, 1, 0, KC_Q);
+    set_keymap({key_a, key_q});
+
+    EXPECT_REPORT(driver, (KC_F24)).Times(1000);
+    EXPECT_EMPTY_REPORT(driver).Times(1000);
+    benchmark(name("combo"), 1000, [&]() {
+        chord({key_a, key_q});
+        scan(COMBO_TERM);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+INSTANTIATE_TEST_CASE_P(ComboCount, ComboBenchmark, testing::Values(1, 10, 50, 150, 250));
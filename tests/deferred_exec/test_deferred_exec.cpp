@@ -0,0 +1,210 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct Invocation {
+    uintptr_t id;
+    uint32_t  time;
+};
+
+static std::vector<Invocation> invocations;
+static uint32_t                repeat_delay = 0;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({(uintptr_t)cb_arg, timer_read32()});
+    return repeat_delay;
+}
+
+class DeferredExec : public TestFixture {
+   public:
+    void SetUp() override {
+        invocations.clear();
+        repeat_delay = 0;
+
+        /* The task throttles on the last time it ran, so the time must keep moving forward between tests. */
+        static uint32_t epoch = 0;
+        epoch += 0x10000;
+        set_time(epoch);
+    }
+
+    void TearDown() override {
+        for (deferred_token token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        TestFixture::TearDown();
+    }
+
+    deferred_token defer(uint32_t delay_ms, uintptr_t id) {
+        deferred_token token = defer_exec(delay_ms, record_callback, (void *)id);
+        tokens.push_back(token);
+        return token;
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+
+    std::vector<uintptr_t> invoked_ids() {
+        std::vector<uintptr_t> ids;
+        for (const Invocation &invocation : invocations) {
+            ids.push_back(invocation.id);
+        }
+        return ids;
+    }
+
+    std::vector<deferred_token> tokens;
+};
+
+TEST_F(DeferredExec, ExecutesAfterDelay) {
+    uint32_t start = timer_read32();
+    defer(10, 1);
+
+    run_for(9);
+    EXPECT_TRUE(invocations.empty());
+
+    run_for(1);
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].time, start + 10);
+
+    run_for(20);
+    EXPECT_EQ(invocations.size(), 1);
+}
+
+TEST_F(DeferredExec, ExecutesInTriggerOrder) {
+    defer(30, 3);
+    defer(10, 1);
+    defer(20, 2);
+    defer(20, 4);
+
+    run_for(30);
+    EXPECT_EQ(invoked_ids(), (std::vector<uintptr_t>{1, 2, 4, 3}));
+}
+
+TEST_F(DeferredExec, SimultaneousTriggersRunInOneTask) {
+    defer(5, 2);
+    defer(3, 1);
+
+    /* Both are overdue by the time the task runs. */
+    advance_time(10);
+    deferred_exec_task();
+    EXPECT_EQ(invoked_ids(), (std::vector<uintptr_t>{1, 2}));
+}
+
+TEST_F(DeferredExec, NextDeadline) {
+    uint32_t deadline = 0;
+    EXPECT_FALSE(deferred_exec_next_deadline(&deadline));
+
+    uint32_t       start = timer_read32();
+    deferred_token later = defer(50, 1);
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, start + 50);
+
+    deferred_token sooner = defer(20, 2);
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, start + 20);
+
+    EXPECT_TRUE(cancel_deferred_exec(sooner));
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, start + 50);
+
+    EXPECT_TRUE(extend_deferred_exec(later, 5));
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, start + 5);
+
+    run_for(5);
+    EXPECT_FALSE(deferred_exec_next_deadline(&deadline));
+}
+
+TEST_F(DeferredExec, ExtendReorders) {
+    deferred_token first = defer(10, 1);
+    defer(20, 2);
+
+    EXPECT_TRUE(extend_deferred_exec(first, 30));
+    run_for(30);
+    EXPECT_EQ(invoked_ids(), (std::vector<uintptr_t>{2, 1}));
+}
+
+TEST_F(DeferredExec, RepeatsAtMostOncePerTask) {
+    repeat_delay = 2;
+    uint32_t start = timer_read32();
+    defer(2, 1);
+
+    /* Running late, the repeat is relative to the previous trigger time, but doesn't catch up in a single task. */
+    advance_time(10);
+    deferred_exec_task();
+    EXPECT_EQ(invocations.size(), 1);
+
+    uint32_t deadline = 0;
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, start + 4);
+
+    repeat_delay = 0;
+    run_for(1);
+    EXPECT_EQ(invocations.size(), 2);
+    EXPECT_FALSE(deferred_exec_next_deadline(&deadline));
+}
+
+static deferred_token cancel_target = INVALID_DEFERRED_TOKEN;
+
+static uint32_t cancelling_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({(uintptr_t)cb_arg, timer_read32()});
+    cancel_deferred_exec(cancel_target);
+    return 0;
+}
+
+TEST_F(DeferredExec, CallbackCancelsAnotherExecutor) {
+    tokens.push_back(defer_exec(5, cancelling_callback, (void *)1));
+    cancel_target = defer(5, 2);
+    defer(5, 3);
+
+    run_for(5);
+    EXPECT_EQ(invoked_ids(), (std::vector<uintptr_t>{1, 3}));
+}
+
+static uint32_t requeueing_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({(uintptr_t)cb_arg, timer_read32()});
+    defer_exec(1, record_callback, (void *)((uintptr_t)cb_arg + 1));
+    return 0;
+}
+
+TEST_F(DeferredExec, CallbackQueuesNewExecutor) {
+    tokens.push_back(defer_exec(5, requeueing_callback, (void *)1));
+
+    run_for(5);
+    EXPECT_EQ(invoked_ids(), (std::vector<uintptr_t>{1}));
+    run_for(1);
+    EXPECT_EQ(invoked_ids(), (std::vector<uintptr_t>{1, 2}));
+}
+
+TEST_F(DeferredExec, TableFull) {
+    for (uintptr_t i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        EXPECT_NE(defer(MAX_DEFERRED_EXECUTORS - i, i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(1, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+
+    run_for(MAX_DEFERRED_EXECUTORS);
+    ASSERT_EQ(invocations.size(), MAX_DEFERRED_EXECUTORS);
+    for (uintptr_t i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        EXPECT_EQ(invocations[i].id, MAX_DEFERRED_EXECUTORS - 1 - i);
+    }
+}
+
+TEST_F(DeferredExec, InvalidArguments) {
+    EXPECT_EQ(defer_exec(0, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec(10, NULL, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(extend_deferred_exec(INVALID_DEFERRED_TOKEN, 10));
+    EXPECT_FALSE(cancel_deferred_exec(INVALID_DEFERRED_TOKEN));
+}
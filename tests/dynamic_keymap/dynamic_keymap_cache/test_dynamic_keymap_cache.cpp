@@ -0,0 +1,43 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+class DynamicKeymapCache : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+    }
+
+    /* Changes a keycode in EEPROM without going through the dynamic keymap API. */
+    void write_eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        eeprom_update_byte(address, keycode >> 8);
+        eeprom_update_byte(address + 1, keycode & 0xFF);
+    }
+};
+
+TEST_F(DynamicKeymapCache, ReadsAreServedFromRam) {
+    dynamic_keymap_set_keycode(1, 1, 1, KC_A);
+    write_eeprom_keycode(1, 1, 1, KC_B);
+
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 1, 1), KC_A);
+
+    /* Reloading picks up the EEPROM contents. */
+    dynamic_keymap_init();
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 1, 1), KC_B);
+}
+
+TEST_F(DynamicKeymapCache, SetBufferWritesThrough) {
+    uint8_t data[] = {KC_C >> 8, KC_C & 0xFF};
+    dynamic_keymap_set_buffer((MATRIX_ROWS * MATRIX_COLS + MATRIX_COLS + 2) * 2, sizeof(data), data);
+
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 1, 2), KC_C);
+}
@@ -0,0 +1,61 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+class DynamicKeymapCacheLayers : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+    }
+
+    /* Changes a keycode in EEPROM without going through the dynamic keymap API. */
+    void write_eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        eeprom_update_byte(address, keycode >> 8);
+        eeprom_update_byte(address + 1, keycode & 0xFF);
+    }
+};
+
+TEST_F(DynamicKeymapCacheLayers, LayersAreLoadedOnFirstUse) {
+    write_eeprom_keycode(1, 0, 0, KC_A);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_A);
+
+    /* Layer 1 is now cached, EEPROM changes behind its back aren't visible. */
+    write_eeprom_keycode(1, 0, 0, KC_B);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_A);
+}
+
+TEST_F(DynamicKeymapCacheLayers, LeastRecentlyUsedLayerIsEvicted) {
+    write_eeprom_keycode(0, 0, 0, KC_A);
+    write_eeprom_keycode(1, 0, 0, KC_B);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_B);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+
+    write_eeprom_keycode(0, 0, 0, KC_C);
+    write_eeprom_keycode(1, 0, 0, KC_D);
+
+    /* Loading layer 2 evicts layer 1, which was used least recently. */
+    dynamic_keymap_get_keycode(2, 0, 0);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_D);
+}
+
+TEST_F(DynamicKeymapCacheLayers, WritesUpdateCachedLayersOnly) {
+    /* Only layer 0 is cached, layer 3 is written to EEPROM only. */
+    dynamic_keymap_get_keycode(0, 0, 0);
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_E);
+    dynamic_keymap_set_keycode(3, 0, 0, KC_F);
+
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_E);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(3, 0, 0), KC_F);
+}
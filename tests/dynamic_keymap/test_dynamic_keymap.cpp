@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "keymap_introspection.h"
+}
+
+class DynamicKeymap : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+    }
+};
+
+TEST_F(DynamicKeymap, ResetCopiesKeymapFromFlash) {
+    for (uint8_t layer = 0; layer < dynamic_keymap_get_layer_count(); layer++) {
+        EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(layer, 1, 2), keycode_at_keymap_location_raw(layer, 1, 2));
+    }
+}
+
+TEST_F(DynamicKeymap, SetKeycodeIsStoredBigEndian) {
+    dynamic_keymap_set_keycode(1, 2, 3, LT(2, KC_A));
+
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(1, 2, 3), LT(2, KC_A));
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(1, 2, 3);
+    EXPECT_EQ(eeprom_read_byte(address), LT(2, KC_A) >> 8);
+    EXPECT_EQ(eeprom_read_byte(address + 1), LT(2, KC_A) & 0xFF);
+}
+
+TEST_F(DynamicKeymap, SetBufferUpdatesKeycodes) {
+    const uint16_t layer_size = MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t        data[layer_size];
+    for (uint16_t i = 0; i < layer_size; i += 2) {
+        data[i]     = (QK_MODS | i) >> 8;
+        data[i + 1] = (QK_MODS | i) & 0xFF;
+    }
+
+    /* Write layer 2 in two uneven chunks, so one keycode is split between them. */
+    dynamic_keymap_set_buffer(2 * layer_size, 7, data);
+    dynamic_keymap_set_buffer(2 * layer_size + 7, layer_size - 7, data + 7);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(2, row, col), QK_MODS | ((row * MATRIX_COLS + col) * 2));
+        }
+    }
+
+    uint8_t read_back[layer_size];
+    dynamic_keymap_get_buffer(2 * layer_size, layer_size, read_back);
+    EXPECT_EQ(memcmp(data, read_back, layer_size), 0);
+}
+
+TEST_F(DynamicKeymap, OutOfRangeReturnsNoKey) {
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(dynamic_keymap_get_layer_count(), 0, 0), KC_NO);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    EXPECT_KEYCODE_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+}
+
+TEST_F(DynamicKeymap, KeymapLocationUsesDynamicKeymap) {
+    dynamic_keymap_set_keycode(3, 0, 1, KC_Q);
+    EXPECT_KEYCODE_EQ(keycode_at_keymap_location(3, 0, 1), KC_Q);
+}
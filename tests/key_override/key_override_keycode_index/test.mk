@@ -0,0 +1,6 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+SRC += ../test_key_overrides.c ../test_key_override.cpp ../test_key_override_benchmark.cpp
@@ -0,0 +1,78 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "test_key_overrides.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class KeyOverrideBenchmark : public BenchmarkFixture, public testing::WithParamInterface<uint16_t> {
+   public:
+    KeymapKey key_lsft = KeymapKey(0, 0, 0, KC_LSFT);
+    KeymapKey key_lctl = KeymapKey(0, 1, 0, KC_LCTL);
+    KeymapKey key_a    = KeymapKey(0, 2, 0, KC_A);
+    KeymapKey key_1    = KeymapKey(0, 3, 0, KC_1);
+    KeymapKey key_2    = KeymapKey(0, 4, 0, KC_2);
+
+    void SetUp() override {
+        key_override_benchmark_setup(GetParam());
+        set_keymap({key_lsft, key_lctl, key_a, key_1, key_2});
+    }
+
+    void TearDown() override {
+        key_overrides = NULL;
+    }
+
+    std::string name(const char* workload) {
+        return std::string(workload) + "_" + std::to_string(GetParam()) + "_overrides";
+    }
+};
+
+TEST_P(KeyOverrideBenchmark, TypingWithoutModifiers) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark(name("typing"), 1000, [&]() {
+        tap(key_1);
+        tap(key_2);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(KeyOverrideBenchmark, TypingShifted) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    benchmark(name("shifted"), 1000, [&]() {
+        press(key_lsft);
+        scan(1);
+        tap(key_1);
+        release(key_lsft);
+        scan(1);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(KeyOverrideBenchmark, ActivatingOverride) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_LCTL)).Times(2000);
+    EXPECT_REPORT(driver, (KC_F13)).Times(1000);
+    EXPECT_EMPTY_REPORT(driver).Times(1000);
+    benchmark(name("override"), 1000, [&]() {
+        press(key_lctl);
+        scan(1);
+        tap(key_a);
+        release(key_lctl);
+        scan(1);
+    });
+    VERIFY_AND_CLEAR(driver);
+}
+
+INSTANTIATE_TEST_CASE_P(KeyOverrideCount, KeyOverrideBenchmark, testing::Values(10, 100, 250));
@@ -0,0 +1,32 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "test_key_overrides.h"
+
+static const key_override_t shift_bspc_delete = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+static const key_override_t shift_bspc_insert = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_INS);
+static const key_override_t ctrl_a_home       = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_HOME);
+static const key_override_t ctrl_shift_a_end  = ko_make_basic(MOD_MASK_CS, KC_A, KC_END);
+
+const key_override_t *key_overrides_basic[]   = {&shift_bspc_delete, NULL};
+const key_override_t *key_overrides_ordered[] = {&ctrl_shift_a_end, &shift_bspc_insert, &ctrl_a_home, &shift_bspc_delete, NULL};
+
+static const uint8_t benchmark_mods[] = {
+    MOD_MASK_CTRL, MOD_MASK_ALT, MOD_MASK_GUI, MOD_MASK_CS, MOD_MASK_CA, MOD_MASK_CG, MOD_MASK_SA, MOD_MASK_SG, MOD_MASK_AG, MOD_MASK_CSA,
+};
+
+static key_override_t        benchmark_overrides[KEY_OVERRIDE_BENCHMARK_MAX];
+static const key_override_t *benchmark_override_list[KEY_OVERRIDE_BENCHMARK_MAX + 1];
+
+void key_override_benchmark_setup(uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        benchmark_overrides[i]     = ko_make_basic(benchmark_mods[i / 26], KC_A + (i % 26), KC_F13 + (i % 12));
+        benchmark_override_list[i] = &benchmark_overrides[i];
+    }
+    benchmark_override_list[count] = NULL;
+    key_overrides                  = benchmark_override_list;
+#ifdef KEY_OVERRIDE_KEYCODE_INDEX
+    key_override_rebuild_index();
+#endif
+}
@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "process_key_override.h"
+
+#define KEY_OVERRIDE_BENCHMARK_MAX 250
+
+extern const key_override_t *key_overrides_basic[];
+extern const key_override_t *key_overrides_ordered[];
+
+/* Fills key_overrides with `count` overrides of letter keys, cycling
+ * through combinations of ctrl, alt, gui and shift once every letter is
+ * used. Override n is triggered by KC_A + n % 26 and sends KC_F13 + n % 12. */
+void key_override_benchmark_setup(uint16_t count);
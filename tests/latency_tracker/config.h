@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define LATENCY_TRACKER_BUCKETS 16
+#define LATENCY_TRACKER_BUCKET_WIDTH 5
@@ -0,0 +1,179 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "latency_tracker.h"
+#include "profiling.h"
+}
+
+using testing::_;
+
+// The test timer is virtual while the profiling timestamp is not, so latencies are compared in milliseconds
+static uint32_t ticks_per_ms() {
+    return profiling_timestamp_frequency() / 1000;
+}
+
+static uint32_t read_u32(const uint8_t* data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+class LatencyTracker : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_tracker_reset();
+    }
+};
+
+TEST_F(LatencyTracker, PlainKeyIsReportedInTheSameScan) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key, 10);
+    VERIFY_AND_CLEAR(driver);
+
+    const latency_stats_t* stats = latency_tracker_get_stats();
+    EXPECT_EQ(stats->count, 2U);
+    EXPECT_LT(stats->max, ticks_per_ms());
+    EXPECT_EQ(stats->histogram[0], 2);
+}
+
+TEST_F(LatencyTracker, TappedModTapIncludesWaitingBuffer) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+
+    set_keymap({key});
+
+    // The tap is only resolved on release, the press spends 30ms in the tapping buffer
+    EXPECT_NO_REPORT(driver);
+    key.press();
+    run_one_scan_loop();
+    idle_for(29);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    const latency_stats_t* stats = latency_tracker_get_stats();
+    EXPECT_EQ(stats->count, 2U);
+    EXPECT_LT(stats->min, ticks_per_ms());
+    EXPECT_EQ(stats->max / ticks_per_ms(), 30U);
+    EXPECT_EQ(stats->histogram[0], 1);
+    EXPECT_EQ(stats->histogram[30 / LATENCY_TRACKER_BUCKET_WIDTH], 1);
+}
+
+TEST_F(LatencyTracker, HeldModTapWaitsForTappingTerm) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key.press();
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    const latency_stats_t* stats = latency_tracker_get_stats();
+    EXPECT_EQ(stats->count, 1U);
+    EXPECT_EQ(stats->max / ticks_per_ms(), (uint32_t)TAPPING_TERM);
+    // Longer than the histogram covers
+    EXPECT_EQ(stats->histogram[LATENCY_TRACKER_BUCKETS - 1], 1);
+    EXPECT_EQ(latency_tracker_percentile(99), stats->max);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTracker, EventsWithoutReportAreDiscarded) {
+    TestDriver driver;
+    auto       layer_key = KeymapKey(0, 0, 0, MO(1));
+    auto       key       = KeymapKey(1, 1, 0, KC_A);
+
+    set_keymap({layer_key, key, KeymapKey(0, 1, 0, KC_B)});
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    const latency_stats_t* stats = latency_tracker_get_stats();
+    EXPECT_EQ(stats->count, 1U);
+    EXPECT_LT(stats->max, ticks_per_ms());
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTracker, PercentileIsUpperBoundOfBucket) {
+    for (int i = 0; i < 99; i++) {
+        latency_tracker_record(7 * ticks_per_ms());
+    }
+    latency_tracker_record(42 * ticks_per_ms());
+
+    EXPECT_EQ(latency_tracker_average(), 735 * ticks_per_ms() / 100);
+    EXPECT_EQ(latency_tracker_percentile(50), 10 * ticks_per_ms() - 1);
+    EXPECT_EQ(latency_tracker_percentile(99), 10 * ticks_per_ms() - 1);
+    EXPECT_EQ(latency_tracker_percentile(100), 42 * ticks_per_ms());
+}
+
+TEST_F(LatencyTracker, RawHidGetStats) {
+    latency_tracker_record(300);
+    latency_tracker_record(1200);
+
+    uint8_t data[32] = {LATENCY_TRACKER_RAW_HID_COMMAND_ID, id_latency_tracker_get_stats};
+    EXPECT_TRUE(latency_tracker_raw_hid_receive(data, sizeof(data)));
+
+    EXPECT_EQ(data[0], LATENCY_TRACKER_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(read_u32(&data[2]), 2U);
+    // min, avg, max
+    EXPECT_EQ(read_u32(&data[6]), 300U);
+    EXPECT_EQ(read_u32(&data[10]), 750U);
+    EXPECT_EQ(read_u32(&data[14]), 1200U);
+    EXPECT_EQ(read_u32(&data[26]), profiling_timestamp_frequency());
+}
+
+TEST_F(LatencyTracker, RawHidGetHistogram) {
+    latency_tracker_record(3 * ticks_per_ms());
+    latency_tracker_record(12 * ticks_per_ms());
+    latency_tracker_record(14 * ticks_per_ms());
+
+    uint8_t data[32] = {LATENCY_TRACKER_RAW_HID_COMMAND_ID, id_latency_tracker_get_histogram, 0x00, 0x01};
+    EXPECT_TRUE(latency_tracker_raw_hid_receive(data, sizeof(data)));
+
+    // 13 buckets fit into a 32 byte report, starting at bucket 1
+    EXPECT_EQ(data[4], 13);
+    EXPECT_EQ(data[6], 0);
+    EXPECT_EQ(data[8], 2);
+}
+
+TEST_F(LatencyTracker, RawHidIgnoresOtherCommands) {
+    uint8_t data[32] = {0x01, id_latency_tracker_get_stats};
+    EXPECT_FALSE(latency_tracker_raw_hid_receive(data, sizeof(data)));
+
+    data[0] = LATENCY_TRACKER_RAW_HID_COMMAND_ID;
+    data[1] = 0x7F;
+    EXPECT_TRUE(latency_tracker_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], 0xFF);
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*******************************************************************************
+  88888888888 888      d8b                .d888 d8b 888               d8b
+      888     888      Y8P               d88P"  Y8P 888               Y8P
+      888     888                        888        888
+      888     88888b.  888 .d8888b       888888 888 888  .d88b.       888 .d8888b
+      888     888 "88b 888 88K           888    888 888 d8P  Y8b      888 88K
+      888     888  888 888 "Y8888b.      888    888 888 88888888      888 "Y8888b.
+      888     888  888 888      X88      888    888 888 Y8b.          888      X88
+      888     888  888 888  88888P'      888    888 888  "Y8888       888  88888P'
+                                                        888                 888
+                                                        888                 888
+                                                        888                 888
+     .d88b.   .d88b.  88888b.   .d88b.  888d888 8888b.  888888 .d88b.   .d88888
+    d88P"88b d8P  Y8b 888 "88b d8P  Y8b 888P"      "88b 888   d8P  Y8b d88" 888
+    888  888 88888888 888  888 88888888 888    .d888888 888   88888888 888  888
+    Y88b 888 Y8b.     888  888 Y8b.     888    888  888 Y88b. Y8b.     Y88b 888
+     "Y88888  "Y8888  888  888  "Y8888  888    "Y888888  "Y888 "Y8888   "Y88888
+         888
+    Y8b d88P
+     "Y88P"
+*******************************************************************************/
+
+#pragma once
+
+// Leader sequences (5 entries):
+//   KC_A -> KC_1
+//   KC_A KC_B -> KC_2
+//   KC_C KC_D -> KC_3
+//   KC_C KC_E KC_F -> LSFT(KC_4)
+//   KC_E -> KC_F24
+
+#define LEADER_TRIE_SIZE 27
+
+static const uint16_t leader_trie[LEADER_TRIE_SIZE] PROGMEM = {
+    0x0003, KC_A, 7, KC_C, 13, KC_E, 25, 0x8001, KC_1, KC_B, 11, 0x8000, KC_2, 0x0002, KC_D, 18,
+    KC_E, 20, 0x8000, KC_3, 0x0001, KC_F, 23, 0x8000, LSFT(KC_4), 0x8000, KC_F24
+};
@@ -0,0 +1,141 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+// The sequences are listed in leader_data.h
+static uint16_t handled_keycode = KC_NO;
+static uint8_t  end_user_count  = 0;
+
+extern "C" bool leader_sequence_matched_user(uint16_t keycode) {
+    if (keycode == KC_F24) {
+        handled_keycode = keycode;
+        return false;
+    }
+    return true;
+}
+
+extern "C" void leader_end_user(void) {
+    end_user_count++;
+}
+
+class LeaderTrie : public TestFixture {
+   public:
+    KeymapKey key_leader = KeymapKey(0, 0, 0, QK_LEADER);
+    KeymapKey key_a      = KeymapKey(0, 1, 0, KC_A);
+    KeymapKey key_b      = KeymapKey(0, 2, 0, KC_B);
+    KeymapKey key_c      = KeymapKey(0, 3, 0, KC_C);
+    KeymapKey key_d      = KeymapKey(0, 4, 0, KC_D);
+    KeymapKey key_e      = KeymapKey(0, 5, 0, KC_E);
+    KeymapKey key_f      = KeymapKey(0, 6, 0, KC_F);
+
+    void SetUp() override {
+        handled_keycode = KC_NO;
+        end_user_count  = 0;
+        set_keymap({key_leader, key_a, key_b, key_c, key_d, key_e, key_f});
+    }
+};
+
+TEST_F(LeaderTrie, unambiguous_sequence_fires_immediately) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_c);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(end_user_count, 1);
+
+    // Keys after the sequence are not part of it
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderTrie, prefix_of_longer_sequence_waits_for_timeout) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    idle_for(250);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(end_user_count, 1);
+}
+
+TEST_F(LeaderTrie, longer_sequence_fires_immediately) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+}
+
+TEST_F(LeaderTrie, sequence_with_modifiers) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_keys(key_c, key_e);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT)).Times(2);
+    EXPECT_REPORT(driver, (KC_LSFT, KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_f);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LeaderTrie, unknown_sequence_only_calls_end_user) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_keys(key_c, key_f, key_d);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(end_user_count, 1);
+}
+
+TEST_F(LeaderTrie, sequence_handled_by_user) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_e);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(handled_keycode, KC_F24);
+    EXPECT_EQ(leader_sequence_active(), false);
+}
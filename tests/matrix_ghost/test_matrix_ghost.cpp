@@ -0,0 +1,142 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+// Ghost detection reads layer 0 of the test keymap, unmapped positions are blanks
+extern "C" uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
+    const KeymapKey *key = TestFixture::m_this->find_key(layer_num, {.col = column, .row = row});
+    return key ? key->code : KC_NO;
+}
+
+class MatrixGhost : public TestFixture {
+   public:
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey key_b = KeymapKey(0, 1, 0, KC_B);
+    KeymapKey key_c = KeymapKey(0, 0, 1, KC_C);
+    KeymapKey key_d = KeymapKey(0, 1, 1, KC_D);
+    KeymapKey key_e = KeymapKey(0, 2, 2, KC_E);
+};
+
+TEST_F(MatrixGhost, ghost_row_is_ignored) {
+    TestDriver driver;
+    set_keymap({key_a, key_b, key_c, key_d, key_e});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Pressing C on a ghosting matrix also closes D, so both rows read the same two columns
+    EXPECT_NO_REPORT(driver);
+    key_c.press();
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Keys on rows that don't share two columns still register
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_E));
+    key_e.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Once B is released, the ghost is gone and the row is processed
+    EXPECT_REPORT(driver, (KC_A, KC_E));
+    EXPECT_REPORT(driver, (KC_A, KC_E, KC_C));
+    key_b.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_E, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_e.release();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixGhost, blanks_do_not_ghost) {
+    TestDriver driver;
+    KeymapKey  blank_d = KeymapKey(0, 1, 1, KC_NO);
+    set_keymap({key_a, key_b, key_c, blank_d});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_c.press();
+    blank_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    key_c.release();
+    blank_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixGhost, keymap_change_updates_real_keys) {
+    TestDriver driver;
+    set_keymap({key_a, key_b, key_c, key_d});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_c.press();
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // D becomes a blank, so the same presses no longer ghost
+    KeymapKey blank_d = KeymapKey(0, 1, 1, KC_NO);
+    set_keymap({key_a, key_b, key_c, blank_d});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    key_a.press();
+    run_one_scan_loop();
+    key_b.press();
+    run_one_scan_loop();
+    key_c.press();
+    blank_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
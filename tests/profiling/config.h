@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define PROFILING_HISTOGRAM_BUCKETS 16
+#define PROFILING_USER_PROBES PROFILE_PROBE(USER_RENDER, "user_render")
@@ -0,0 +1,155 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "profiling.h"
+}
+
+using testing::_;
+
+class Profiling : public TestFixture {
+   public:
+    void SetUp() override {
+        profiling_reset();
+    }
+};
+
+static uint32_t read_u32(const uint8_t* data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+TEST_F(Profiling, RecordsMinAverageMax) {
+    profiling_record(PROFILE_PROBE_USER_RENDER, 10);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 30);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 20);
+
+    const profile_stats_t* stats = profiling_get_stats(PROFILE_PROBE_USER_RENDER);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->count, 3U);
+    EXPECT_EQ(stats->min, 10U);
+    EXPECT_EQ(stats->max, 30U);
+    EXPECT_EQ(profiling_average(PROFILE_PROBE_USER_RENDER), 20U);
+    EXPECT_STREQ(profiling_probe_name(PROFILE_PROBE_USER_RENDER), "user_render");
+}
+
+TEST_F(Profiling, HistogramUsesLog2Buckets) {
+    profiling_record(PROFILE_PROBE_USER_RENDER, 0);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 1);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 2);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 3);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 1000);
+    profiling_record(PROFILE_PROBE_USER_RENDER, UINT32_MAX);
+
+    const profile_stats_t* stats = profiling_get_stats(PROFILE_PROBE_USER_RENDER);
+    EXPECT_EQ(stats->histogram[0], 1);
+    EXPECT_EQ(stats->histogram[1], 1);
+    EXPECT_EQ(stats->histogram[2], 2);
+    EXPECT_EQ(stats->histogram[10], 1);
+    // Everything too long for the histogram ends up in the last bucket
+    EXPECT_EQ(stats->histogram[PROFILING_HISTOGRAM_BUCKETS - 1], 1);
+}
+
+TEST_F(Profiling, PercentileIsUpperBoundOfBucket) {
+    for (int i = 0; i < 99; i++) {
+        profiling_record(PROFILE_PROBE_USER_RENDER, 10);
+    }
+    profiling_record(PROFILE_PROBE_USER_RENDER, 5000);
+
+    EXPECT_EQ(profiling_percentile(PROFILE_PROBE_USER_RENDER, 50), 15U);
+    EXPECT_EQ(profiling_percentile(PROFILE_PROBE_USER_RENDER, 99), 15U);
+    EXPECT_EQ(profiling_percentile(PROFILE_PROBE_USER_RENDER, 100), 5000U);
+}
+
+TEST_F(Profiling, EmptyProbeReportsZero) {
+    EXPECT_EQ(profiling_average(PROFILE_PROBE_USER_RENDER), 0U);
+    EXPECT_EQ(profiling_percentile(PROFILE_PROBE_USER_RENDER, 99), 0U);
+    EXPECT_EQ(profiling_get_stats(PROFILE_PROBE_COUNT), nullptr);
+    EXPECT_EQ(profiling_probe_name(PROFILE_PROBE_COUNT), nullptr);
+}
+
+TEST_F(Profiling, KeyboardTaskFeedsProbes) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(profiling_get_stats(PROFILE_PROBE_MATRIX_TASK)->count, 10U);
+    EXPECT_EQ(profiling_get_stats(PROFILE_PROBE_QUANTUM_TASK)->count, 10U);
+    EXPECT_EQ(profiling_get_stats(PROFILE_PROBE_CAPS_WORD_TASK)->count, 10U);
+    EXPECT_EQ(profiling_get_stats(PROFILE_PROBE_LED_TASK)->count, 10U);
+    EXPECT_GE(profiling_get_stats(PROFILE_PROBE_QUANTUM_TASK)->max, profiling_get_stats(PROFILE_PROBE_CAPS_WORD_TASK)->min);
+}
+
+TEST_F(Profiling, TimestampIsMonotonic) {
+    uint32_t first  = profiling_timestamp();
+    uint32_t second = profiling_timestamp();
+    EXPECT_LT(second - first, profiling_timestamp_frequency());
+    EXPECT_EQ(profiling_timestamp_frequency(), 1000000000U);
+}
+
+TEST_F(Profiling, RawHidInfo) {
+    uint8_t data[32] = {PROFILING_RAW_HID_COMMAND_ID, id_profiling_get_info};
+
+    EXPECT_TRUE(profiling_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], PROFILING_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(data[2], PROFILE_PROBE_COUNT);
+    EXPECT_EQ(data[3], PROFILING_HISTOGRAM_BUCKETS);
+    EXPECT_EQ(read_u32(&data[4]), profiling_timestamp_frequency());
+}
+
+TEST_F(Profiling, RawHidStats) {
+    profiling_record(PROFILE_PROBE_USER_RENDER, 100);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 300);
+
+    uint8_t data[32] = {PROFILING_RAW_HID_COMMAND_ID, id_profiling_get_stats, PROFILE_PROBE_USER_RENDER};
+    EXPECT_TRUE(profiling_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[0], PROFILING_RAW_HID_COMMAND_ID);
+    EXPECT_EQ(read_u32(&data[3]), 2U);
+    EXPECT_EQ(read_u32(&data[7]), 100U);
+    EXPECT_EQ(read_u32(&data[11]), 200U);
+    EXPECT_EQ(read_u32(&data[15]), 300U);
+    EXPECT_EQ(read_u32(&data[19]), 300U);
+    EXPECT_EQ(std::string((const char*)&data[23], 9), std::string("user_rend"));
+}
+
+TEST_F(Profiling, RawHidHistogram) {
+    profiling_record(PROFILE_PROBE_USER_RENDER, 2);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 3);
+    profiling_record(PROFILE_PROBE_USER_RENDER, 40);
+
+    uint8_t data[32] = {PROFILING_RAW_HID_COMMAND_ID, id_profiling_get_histogram, PROFILE_PROBE_USER_RENDER, 0};
+    EXPECT_TRUE(profiling_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[4], 13);
+    EXPECT_EQ(data[5 + 2 * 2 + 1], 2);
+    EXPECT_EQ(data[5 + 6 * 2 + 1], 1);
+
+    uint8_t tail[32] = {PROFILING_RAW_HID_COMMAND_ID, id_profiling_get_histogram, PROFILE_PROBE_USER_RENDER, 13};
+    EXPECT_TRUE(profiling_raw_hid_receive(tail, sizeof(tail)));
+    EXPECT_EQ(tail[4], PROFILING_HISTOGRAM_BUCKETS - 13);
+}
+
+TEST_F(Profiling, RawHidRejectsInvalidRequests) {
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(profiling_raw_hid_receive(other, sizeof(other)));
+
+    uint8_t bad_probe[32] = {PROFILING_RAW_HID_COMMAND_ID, id_profiling_get_stats, PROFILE_PROBE_COUNT};
+    EXPECT_TRUE(profiling_raw_hid_receive(bad_probe, sizeof(bad_probe)));
+    EXPECT_EQ(bad_probe[0], 0xFF);
+}
+
+TEST_F(Profiling, RawHidReset) {
+    profiling_record(PROFILE_PROBE_USER_RENDER, 100);
+
+    uint8_t data[32] = {PROFILING_RAW_HID_COMMAND_ID, id_profiling_reset_stats};
+    EXPECT_TRUE(profiling_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(profiling_get_stats(PROFILE_PROBE_USER_RENDER)->count, 0U);
+}
@@ -0,0 +1,159 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   public:
+    void TearDown() override {
+        send_string_async_cancel();
+        TestFixture::TearDown();
+    }
+};
+
+TEST_F(SendStringAsync, QueueingDoesNotSendReports) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async_with_delay("ab", 0));
+    EXPECT_TRUE(send_string_async_is_busy());
+    EXPECT_EQ(send_string_async_queued(), 4);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, TypesOneActionPerTask) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay("aB", 0));
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, IntervalIsAppliedBetweenActions) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay("a", 10));
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(9);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, KeysAreProcessedDuringDelay) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_c = KeymapKey(0, 0, 0, KC_C);
+    set_keymap({key_c});
+
+    EXPECT_TRUE(send_string_async_with_delay(SS_DELAY(100) "a", 0));
+
+    /* The delay doesn't hold up the physical key. */
+    EXPECT_REPORT(driver, (KC_C));
+    key_c.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    key_c.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(90);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, SpecialSequences) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay(SS_DOWN(X_LCTL) SS_TAP(X_C) SS_UP(X_LCTL), 0));
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, QueueFull) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    /* Each string takes its length plus two bytes of the 16 byte queue. */
+    EXPECT_TRUE(send_string_async_with_delay("abcdef", 0));
+    EXPECT_FALSE(send_string_async_with_delay("ghijklm", 0));
+    EXPECT_TRUE(send_string_async_with_delay("ghijkl", 0));
+    EXPECT_EQ(send_string_async_queued(), 16);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Both strings are typed in order, wrapping around the queue. */
+    EXPECT_ANY_REPORT(driver).Times(24);
+    idle_for(24);
+    EXPECT_EQ(send_string_async_queued(), 0);
+    EXPECT_TRUE(send_string_async_with_delay("mnopqrstuvwxyz", 0));
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay(SS_DOWN(X_LSFT) "abc", 0));
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    idle_for(2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,121 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_benchmark.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "test_matrix.h"
+
+extern "C" {
+#include "keyboard.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+static uint64_t cpu_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+double BenchmarkResult::cpu_ns_per_event() const {
+    return events ? (double)cpu_ns / events : 0.0;
+}
+
+double BenchmarkResult::simulated_ms_per_event() const {
+    return events ? (double)simulated_ms / events : 0.0;
+}
+
+BenchmarkResult BenchmarkFixture::benchmark(const std::string& name, uint32_t iterations, const std::function<void()>& workload) {
+    m_events = 0;
+
+    uint32_t sim_start = timer_read32();
+    uint64_t cpu_start = cpu_time_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+        workload();
+    }
+    uint64_t cpu_end = cpu_time_ns();
+    uint32_t sim_end = timer_read32();
+
+    const ::testing::TestInfo* const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+
+    BenchmarkResult result = {
+        .suite        = test_info ? test_info->test_suite_name() : "",
+        .name         = name,
+        .iterations   = iterations,
+        .events       = m_events,
+        .cpu_ns       = cpu_end - cpu_start,
+        .simulated_ms = sim_end - sim_start,
+    };
+    report(result);
+    return result;
+}
+
+void BenchmarkFixture::press(const KeymapKey& key) {
+    press_key(key.position.col, key.position.row);
+    m_events++;
+}
+
+void BenchmarkFixture::release(const KeymapKey& key) {
+    release_key(key.position.col, key.position.row);
+    m_events++;
+}
+
+void BenchmarkFixture::tap(const KeymapKey& key, unsigned delay_ms) {
+    press(key);
+    scan(delay_ms);
+    release(key);
+    scan(1);
+}
+
+void BenchmarkFixture::chord(const std::vector<KeymapKey>& keys, unsigned delay_ms) {
+    for (const KeymapKey& key : keys) {
+        press(key);
+    }
+    scan(delay_ms);
+    for (const KeymapKey& key : keys) {
+        release(key);
+    }
+    scan(1);
+}
+
+void BenchmarkFixture::scan(unsigned ms) {
+    for (unsigned i = 0; i < ms; i++) {
+        keyboard_task();
+        housekeeping_task();
+        advance_time(1);
+    }
+}
+
+void BenchmarkFixture::report(const BenchmarkResult& result) {
+    RecordProperty(result.name + ".iterations", std::to_string(result.iterations));
+    RecordProperty(result.name + ".events", std::to_string(result.events));
+    RecordProperty(result.name + ".cpu_ns", std::to_string(result.cpu_ns));
+    RecordProperty(result.name + ".simulated_ms", std::to_string(result.simulated_ms));
+    RecordProperty(result.name + ".cpu_ns_per_event", std::to_string(result.cpu_ns_per_event()));
+    RecordProperty(result.name + ".simulated_ms_per_event", std::to_string(result.simulated_ms_per_event()));
+
+    std::cout << "[ BENCH    ] " << result.suite << "." << result.name << ": " << result.events << " events, " << std::fixed << std::setprecision(1) << result.cpu_ns_per_event() << " ns/event, " << std::setprecision(3) << result.simulated_ms_per_event() << " simulated ms/event" << std::endl;
+
+    const char* csv_path = std::getenv("QMK_BENCHMARK_CSV");
+    if (csv_path == nullptr || *csv_path == '\0') {
+        return;
+    }
+
+    FILE* csv = fopen(csv_path, "a+");
+    if (csv == nullptr) {
+        ADD_FAILURE() << "unable to open benchmark output " << csv_path;
+        return;
+    }
+    fseek(csv, 0, SEEK_END);
+    if (ftell(csv) == 0) {
+        fprintf(csv, "suite,name,iterations,events,cpu_ns,simulated_ms,cpu_ns_per_event,simulated_ms_per_event\n");
+    }
+    fprintf(csv, "%s,%s,%u,%u,%llu,%u,%.1f,%.3f\n", result.suite.c_str(), result.name.c_str(), result.iterations, result.events, (unsigned long long)result.cpu_ns, result.simulated_ms, result.cpu_ns_per_event(), result.simulated_ms_per_event());
+    fclose(csv);
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+/**
+ * @brief Result of a single benchmark run, one row of the machine-readable output.
+ */
+struct BenchmarkResult {
+    std::string suite;
+    std::string name;
+    uint32_t    iterations;
+    uint32_t    events;
+    uint64_t    cpu_ns;
+    uint32_t    simulated_ms;
+
+    double cpu_ns_per_event() const;
+    double simulated_ms_per_event() const;
+};
+
+/**
+ * @brief Test fixture for host-side scan-loop benchmarks.
+ *
+ * Workloads drive `keyboard_task()` through the mocked timer and the test matrix
+ * without the test logger and gmock bookkeeping that `TestFixture::idle_for()`
+ * and `KeymapKey::press()` add, so the measured CPU time is dominated by QMK code.
+ *
+ * Every result is attached to the running test as gtest properties, so
+ * `--gtest_output=json:<file>` yields machine-readable output. If the
+ * `QMK_BENCHMARK_CSV` environment variable names a file, results are also
+ * appended to it as CSV rows.
+ */
+class BenchmarkFixture : public TestFixture {
+   public:
+    /**
+     * @brief Runs `workload` `iterations` times and records CPU time and simulated
+     * time per matrix event.
+     */
+    BenchmarkResult benchmark(const std::string& name, uint32_t iterations, const std::function<void()>& workload);
+
+    /** @brief Presses `key` on the test matrix and counts one event. */
+    void press(const KeymapKey& key);
+    /** @brief Releases `key` on the test matrix and counts one event. */
+    void release(const KeymapKey& key);
+    /** @brief Presses `key`, scans for `delay_ms`, releases it and scans once. */
+    void tap(const KeymapKey& key, unsigned delay_ms = 1);
+    /** @brief Presses all `keys` in order, scans for `delay_ms`, then releases them in order. */
+    void chord(const std::vector<KeymapKey>& keys, unsigned delay_ms = 1);
+    /** @brief Runs `ms` iterations of the keyboard and housekeeping tasks, advancing the timer by 1ms each. */
+    void scan(unsigned ms);
+
+   private:
+    void report(const BenchmarkResult& result);
+
+    uint32_t m_events = 0;
+};
@@ -100,6 +100,12 @@ void TestFixture::add_key(KeymapKey key) {
     }
 
     this->keymap.push_back(key);
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_clear();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    ghost_real_keys_clear();
+#endif
 }
 
 void TestFixture::tap_key(KeymapKey key, unsigned delay_ms) {
@@ -127,6 +133,12 @@ void TestFixture::tap_combo(const std::vector<KeymapKey>& chord_keys, unsigned d
 
 void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
     this->keymap.clear();
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+    layer_lookup_cache_clear();
+#endif
+#ifdef MATRIX_HAS_GHOST
+    ghost_real_keys_clear();
+#endif
     for (auto& key : keys) {
         add_key(key);
     }
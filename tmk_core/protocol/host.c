@@ -35,6 +35,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "outputselect.h"
 #endif
 
+#ifdef LATENCY_TRACKER_ENABLE
+#    include "latency_tracker.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 extern keymap_config_t keymap_config;
@@ -73,6 +77,10 @@ led_t host_keyboard_led_state(void) {
 
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef LATENCY_TRACKER_ENABLE
+    latency_tracker_report_sent();
+#endif
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -97,6 +105,9 @@ void host_keyboard_send(report_keyboard_t *report) {
 
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
+#ifdef LATENCY_TRACKER_ENABLE
+    latency_tracker_report_sent();
+#endif
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
 